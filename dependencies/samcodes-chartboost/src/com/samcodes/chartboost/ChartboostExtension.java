@@ -11,6 +11,8 @@ import android.view.View;
 import android.view.View.OnClickListener;
 import android.widget.Button;
 import android.widget.ImageView;
+import java.util.ArrayList;
+import java.util.LinkedHashMap;
 import org.haxe.extension.Extension;
 import org.haxe.lime.HaxeObject;
 import com.chartboost.sdk.Chartboost;
@@ -19,6 +21,8 @@ import com.chartboost.sdk.Chartboost.CBPIDataUseConsent;
 import com.chartboost.sdk.Model.CBError.CBClickError;
 import com.chartboost.sdk.Model.CBError.CBImpressionError;
 import com.chartboost.sdk.CBLocation;
+import com.chartboost.sdk.Tracking.CBAnalytics;
+import com.chartboost.sdk.Tracking.CBAnalytics.CBLevelType;
 
 public class ChartboostExtension extends Extension
 {
@@ -65,6 +69,9 @@ public class ChartboostExtension extends Extension
 
 		@Override
 		public boolean shouldDisplayInterstitial(String location) {
+			// Showing an ad is a natural pause point, so any buffered level tracking is sent now
+			flushLevelInfo();
+			
 			Log.i(TAG, "SHOULD DISPLAY INTERSTITIAL " + (location != null ? location : "null"));
 			
 			if(location != null) {
@@ -148,6 +155,9 @@ public class ChartboostExtension extends Extension
 
 		@Override
 		public boolean shouldDisplayRewardedVideo(String location) {
+			// Showing an ad is a natural pause point, so any buffered level tracking is sent now
+			flushLevelInfo();
+			
 			Log.i(TAG, "SHOULD DISPLAY REWARDED VIDEO: " + (location != null ? location : "null"));
 			
 			if(location != null) {
@@ -373,4 +383,79 @@ public class ChartboostExtension extends Extension
 	public static int getPIDataUseConsent() {
 		return Chartboost.getPIDataUseConsent().getValue();
 	}
+	
+	private static class LevelInfo {
+		public String label;
+		public int levelType;
+		public int mainLevel;
+		public int subLevel;
+		public String description;
+	}
+	
+	// Level tracking is buffered and sent in batches. Repeated events for the same label and level type replace each other
+	private static LinkedHashMap<String, LevelInfo> pendingLevelInfo = new LinkedHashMap<String, LevelInfo>();
+	private static boolean levelInfoFlushScheduled = false;
+	private static long levelInfoFlushIntervalMillis = 30000;
+	private static Runnable levelInfoFlushRunnable = new Runnable() {
+		public void run() {
+			flushLevelInfo();
+		}
+	};
+	
+	public static void trackLevelInfo(String label, int levelType, int mainLevel, int subLevel, String description) {
+		LevelInfo info = new LevelInfo();
+		info.label = label;
+		info.levelType = levelType;
+		info.mainLevel = mainLevel;
+		info.subLevel = subLevel;
+		info.description = description;
+		
+		boolean scheduleFlush = false;
+		synchronized(pendingLevelInfo) {
+			pendingLevelInfo.put(label + "#" + levelType, info);
+			if(!levelInfoFlushScheduled) {
+				levelInfoFlushScheduled = true;
+				scheduleFlush = true;
+			}
+		}
+		
+		if(scheduleFlush) {
+			callbackHandler.postDelayed(levelInfoFlushRunnable, levelInfoFlushIntervalMillis);
+		}
+	}
+	
+	public static void flushLevelInfo() {
+		ArrayList<LevelInfo> batch;
+		synchronized(pendingLevelInfo) {
+			batch = new ArrayList<LevelInfo>(pendingLevelInfo.values());
+			pendingLevelInfo.clear();
+			levelInfoFlushScheduled = false;
+		}
+		
+		for(LevelInfo info : batch) {
+			CBLevelType type = getLevelType(info.levelType);
+			if(type == null) {
+				Log.w(TAG, "Ignoring level info with invalid level type: " + info.levelType);
+				continue;
+			}
+			CBAnalytics.trackLevelInfo(info.label, type, info.mainLevel, info.subLevel, info.description);
+		}
+	}
+	
+	public static void requestLevelInfoFlush() {
+		callbackHandler.post(levelInfoFlushRunnable);
+	}
+	
+	public static void setLevelInfoFlushInterval(double seconds) {
+		levelInfoFlushIntervalMillis = (long)(seconds * 1000.0);
+	}
+	
+	private static CBLevelType getLevelType(int levelType) {
+		for(CBLevelType type : CBLevelType.values()) {
+			if(type.getLevelType() == levelType) {
+				return type;
+			}
+		}
+		return null;
+	}
 }
\ No newline at end of file
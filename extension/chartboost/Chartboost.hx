@@ -5,6 +5,9 @@ package extension.chartboost;
 #if android
 import lime.system.JNI;
 #end
+#if ios
+import haxe.io.Bytes;
+#end
 
 /**
    The Chartboost class provides bindings to the main functionality of the Chartboost ads SDK on iOS and Android
@@ -24,6 +27,30 @@ class Chartboost {
 		#end
 	}
 	
+	#if ios
+	/**
+	   Sends events to a static function through a plain C function pointer instead of to the listener, so there's no boxing or dynamic call per event.
+	   Create the callback with cpp.Callable.fromStaticFunction. Its arguments are a ChartboostEventType, a location index (see ChartboostEventQueue.getLocationName), the SDK error id or -1, the reward amount and a status flag.
+	**/
+	public static function setEventCallback(callback:cpp.Callable<Int->Int->Int->Int->Bool->Void>):Void {
+		ChartboostNative.setEventCallback(callback);
+	}
+	
+	/**
+	   Goes back to sending events to the listener.
+	**/
+	public static function clearEventCallback():Void {
+		ChartboostNative.clearEventCallback();
+	}
+	
+	/**
+	   When on, events for the listener, the event callback or ChartboostListeners are queued natively and delivered in one batch per main thread wakeup, with at most one wakeup pending at a time.
+	**/
+	public static function setEventCoalescing(coalesce:Bool):Void {
+		set_event_coalescing(coalesce);
+	}
+	#end
+	
 	public static function showInterstitial(id:String):Void {
 		show_interstitial(id);
 	}
@@ -108,6 +135,133 @@ class Chartboost {
 		set_pi_data_use_consent(consent);
 	}
 	
+	#if ios
+	/**
+	   Consent is cached natively and persisted between launches, so getPIDataUseConsent is answered from memory.
+	   Changing it sends it to the SDK, applies this policy to placements requested under the old consent, and persists it, all in the one call.
+	   The SDK won't replace an ad it already holds, so under RECACHE a stale placement is requested again once its ad has been shown.
+	**/
+	public static function setConsentChangePolicy(policy:ChartboostConsentPolicy):Void {
+		set_consent_change_policy(policy);
+	}
+	
+	public static function getConsentChangePolicy():ChartboostConsentPolicy {
+		return get_consent_change_policy();
+	}
+	
+	/**
+	   Whether the location is requesting or holding an ad that was requested before the last consent change. The index comes from ChartboostLocationStates.getIndex.
+	**/
+	public static function isConsentStale(type:ChartboostAdType, index:Int):Bool {
+		return is_consent_stale(type, index);
+	}
+	
+	public static function getConsentChangeCount():Int {
+		return get_consent_change_count();
+	}
+	#end
+	
+	/**
+	   Buffers level information for the SDK. This only appends to a native buffer, where repeated events for the same label and level type replace each other.
+	   The buffer is sent in one batch on a timer, before an ad is shown, or when flushLevelInfo is called.
+	**/
+	public static function trackLevelInfo(label:String, type:ChartboostLevelType, mainLevel:Int, subLevel:Int, description:String):Void {
+		track_level_info(label, type, mainLevel, subLevel, description);
+	}
+	
+	/**
+	   Sends any buffered level information soon, call this at natural pause points such as level ends.
+	**/
+	public static function flushLevelInfo():Void {
+		flush_level_info();
+	}
+	
+	/**
+	   Sets how long buffered level information waits before being sent. Defaults to 30 seconds.
+	**/
+	public static function setLevelInfoFlushInterval(seconds:Float):Void {
+		set_level_info_flush_interval(seconds);
+	}
+	
+	#if ios
+	/**
+	   Gets a banner for the location from the native banner pool, creating one only if there is no released banner with the same size and location.
+	   Returns a handle to pass to the other banner methods, or 0 on failure.
+	**/
+	public static function acquireBanner(location:String, size:ChartboostBannerSize):Int {
+		return acquire_banner(location, size);
+	}
+	
+	/**
+	   Hides the banner and returns it to the pool. The handle must not be used again.
+	**/
+	public static function releaseBanner(handle:Int):Void {
+		release_banner(handle);
+	}
+	
+	public static function showBanner(handle:Int):Void {
+		show_banner(handle);
+	}
+	
+	public static function hideBanner(handle:Int):Void {
+		hide_banner(handle);
+	}
+	
+	/**
+	   Positions the banner, in points relative to the top left of the root view.
+	**/
+	public static function setBannerPosition(handle:Int, x:Float, y:Float):Void {
+		set_banner_position(handle, x, y);
+	}
+	
+	/**
+	   Sets how often a visible banner fetches a new creative. Pass 0 to disable refreshing for the banner. Defaults to 30 seconds.
+	**/
+	public static function setBannerRefreshInterval(handle:Int, seconds:Float):Void {
+		set_banner_refresh_interval(handle, seconds);
+	}
+	
+	public static function isBannerCached(handle:Int):Bool {
+		return is_banner_cached(handle);
+	}
+	
+	/**
+	   Advances the banner refresh timers, call this once per frame. Refreshes are postponed while frameBudgetTight is true.
+	**/
+	public static function updateBanners(dt:Float, frameBudgetTight:Bool):Void {
+		update_banners(dt, frameBudgetTight);
+	}
+	
+	/**
+	   Destroys all released banners in the pool, e.g. in response to a memory warning.
+	**/
+	public static function drainBannerPool():Void {
+		drain_banner_pool();
+	}
+	
+	/**
+	   Tracks an in-app purchase. The purchase is written to a persistent native queue and sent to the SDK from a background thread once it has initialized and the device is reachable, so nothing is lost if the app is offline or closed first.
+	   The receipt is the raw transaction receipt, it's base64 encoded off the game thread. The price may be formatted for display, such as "$0.99" or "0,99 €", a purchase whose price has no digits is logged and dropped.
+	**/
+	public static function trackInAppPurchase(receipt:Bytes, title:String, description:String, price:String, currency:String, productId:String):Void {
+		track_in_app_purchase(receipt, title, description, price, currency, productId);
+	}
+	
+	/**
+	   Tracks an in-app purchase with an already base64 encoded receipt, see trackInAppPurchase.
+	**/
+	public static function trackInAppPurchaseWithString(receiptBase64:String, title:String, description:String, price:String, currency:String, productId:String):Void {
+		track_in_app_purchase_with_string(receiptBase64, title, description, price, currency, productId);
+	}
+	
+	/**
+	   Number of tracked purchases still waiting to be sent to the SDK.
+	**/
+	public static function getQueuedPurchaseCount():Int {
+		return get_queued_purchase_count();
+	}
+	#end
+	
 	#if android
 	private static inline var packageName:String = "com/samcodes/chartboost/ChartboostExtension";
 	private static inline function bindJNI(jniMethod:String, jniSignature:String) {
@@ -136,6 +290,9 @@ class Chartboost {
 	private static var restrict_data_collection = bindJNI("restrictDataCollection", "(Z)V");
 	private static var get_pi_data_use_consent = bindJNI("getPIDataUseConsent", "()I");
 	private static var set_pi_data_use_consent = bindJNI("setPIDataUseConsent", "(I)V");
+	private static var track_level_info = bindJNI("trackLevelInfo", "(Ljava/lang/String;IIILjava/lang/String;)V");
+	private static var flush_level_info = bindJNI("requestLevelInfoFlush", "()V");
+	private static var set_level_info_flush_interval = bindJNI("setLevelInfoFlushInterval", "(D)V");
 	#end
 	
 	#if ios
@@ -160,6 +317,26 @@ class Chartboost {
 	private static var restrict_data_collection = PrimeLoader.load("samcodeschartboost_restrict_data_collection", "bv");
 	private static var get_pi_data_use_consent = PrimeLoader.load("samcodeschartboost_get_pi_data_use_consent", "i");
 	private static var set_pi_data_use_consent = PrimeLoader.load("samcodeschartboost_set_pi_data_use_consent", "iv");
+	private static var set_consent_change_policy = PrimeLoader.load("samcodeschartboost_set_consent_change_policy", "iv");
+	private static var get_consent_change_policy = PrimeLoader.load("samcodeschartboost_get_consent_change_policy", "i");
+	private static var is_consent_stale = PrimeLoader.load("samcodeschartboost_is_consent_stale", "iib");
+	private static var get_consent_change_count = PrimeLoader.load("samcodeschartboost_get_consent_change_count", "i");
+	private static var acquire_banner = PrimeLoader.load("samcodeschartboost_acquire_banner", "sii");
+	private static var release_banner = PrimeLoader.load("samcodeschartboost_release_banner", "iv");
+	private static var show_banner = PrimeLoader.load("samcodeschartboost_show_banner", "iv");
+	private static var hide_banner = PrimeLoader.load("samcodeschartboost_hide_banner", "iv");
+	private static var set_banner_position = PrimeLoader.load("samcodeschartboost_set_banner_position", "iddv");
+	private static var set_banner_refresh_interval = PrimeLoader.load("samcodeschartboost_set_banner_refresh_interval", "idv");
+	private static var is_banner_cached = PrimeLoader.load("samcodeschartboost_is_banner_cached", "ib");
+	private static var update_banners = PrimeLoader.load("samcodeschartboost_update_banners", "dbv");
+	private static var drain_banner_pool = PrimeLoader.load("samcodeschartboost_drain_banner_pool", "v");
+	private static var track_level_info = PrimeLoader.load("samcodeschartboost_track_level_info", "siiisv");
+	private static var flush_level_info = PrimeLoader.load("samcodeschartboost_flush_level_info", "v");
+	private static var set_level_info_flush_interval = PrimeLoader.load("samcodeschartboost_set_level_info_flush_interval", "dv");
+	private static var track_in_app_purchase = PrimeLoader.load("samcodeschartboost_track_in_app_purchase", "osssssv");
+	private static var track_in_app_purchase_with_string = PrimeLoader.load("samcodeschartboost_track_in_app_purchase_with_string", "ssssssv");
+	private static var get_queued_purchase_count = PrimeLoader.load("samcodeschartboost_get_queued_purchase_count", "i");
+	private static var set_event_coalescing = PrimeLoader.load("samcodeschartboost_set_event_coalescing", "bv");
 	#end
 }
 
@@ -0,0 +1,48 @@
+package extension.chartboost;
+
+#if ios
+
+/**
+   An interstitial or rewarded video ad object backed by a native handle.
+   Create these once, e.g. at startup, and keep them around. The cache state is tracked natively, so isCached is cheap enough to poll every frame.
+**/
+class ChartboostAd {
+	public var type(default, null):ChartboostAdType;
+	public var location(default, null):String;
+	
+	private var handle:Int;
+	
+	public function new(type:ChartboostAdType, location:String) {
+		this.type = type;
+		this.location = location;
+		handle = create_ad(type, location);
+	}
+	
+	public function cache():Void {
+		cache_ad(handle);
+	}
+	
+	public function show():Void {
+		show_ad(handle);
+	}
+	
+	public function isCached():Bool {
+		return is_ad_cached(handle);
+	}
+	
+	/**
+	   Releases the native handle. The ad object must not be used afterwards.
+	**/
+	public function dispose():Void {
+		release_ad(handle);
+		handle = 0;
+	}
+	
+	private static var create_ad = PrimeLoader.load("samcodeschartboost_create_ad", "isi");
+	private static var release_ad = PrimeLoader.load("samcodeschartboost_release_ad", "iv");
+	private static var cache_ad = PrimeLoader.load("samcodeschartboost_cache_ad", "iv");
+	private static var show_ad = PrimeLoader.load("samcodeschartboost_show_ad", "iv");
+	private static var is_ad_cached = PrimeLoader.load("samcodeschartboost_is_ad_cached", "ib");
+}
+
+#end
\ No newline at end of file
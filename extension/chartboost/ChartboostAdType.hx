@@ -0,0 +1,10 @@
+package extension.chartboost;
+
+/**
+    Enum for the kinds of ad that can be created as ad objects, see ChartboostAd.
+**/
+@:enum abstract ChartboostAdType(Int) from Int to Int
+{
+	var INTERSTITIAL = 0;
+	var REWARDED_VIDEO = 1;
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+package extension.chartboost;
+
+#if ios
+
+/**
+   Counts the native heap and hxcpp GC allocations made by each binding and on the delivery path of each event type, for catching changes that add allocations to hot paths.
+   Only collected when the ndlls are built with -Dsamcodeschartboost_audit_allocations, otherwise the audit is always empty.
+**/
+class ChartboostAllocationAudit {
+	/**
+	   One line per binding or event type seen since the last reset: "<binding|event>\t<name>\t<calls>\t<native allocations>\t<native bytes>\t<gc allocations>\t<gc bytes>".
+	   Native allocations cover operator new, strdup and NSString copies. GC allocations cover the strings and objects the extension creates for Haxe.
+	**/
+	public static function getAudit():String {
+		return get_allocation_audit();
+	}
+	
+	public static function reset():Void {
+		reset_allocation_audit();
+	}
+	
+	private static var get_allocation_audit = PrimeLoader.load("samcodeschartboost_get_allocation_audit", "s");
+	private static var reset_allocation_audit = PrimeLoader.load("samcodeschartboost_reset_allocation_audit", "v");
+}
+
+#end
\ No newline at end of file
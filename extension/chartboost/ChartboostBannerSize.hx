@@ -0,0 +1,15 @@
+package extension.chartboost;
+
+/**
+    Enum for the standard Chartboost banner sizes.
+    Note this enum needs updating whenever the Chartboost SDK is updated/changes or adds new banner sizes, else there's no guarantee that the mapping here is correct.
+**/
+@:enum abstract ChartboostBannerSize(Int) from Int to Int
+{
+	/* "Banner" - Standard banner size on phones. */
+	var STANDARD = 0;
+	/* "Medium Rect" - Medium banner size on phones. */
+	var MEDIUM = 1;
+	/* "Tablet" - Leaderboard banner size on tablets. */
+	var LEADERBOARD = 2;
+}
\ No newline at end of file
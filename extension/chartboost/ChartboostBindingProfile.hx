@@ -0,0 +1,26 @@
+package extension.chartboost;
+
+#if ios
+
+/**
+   Call counts and timings for each native binding, for finding out what the extension costs per frame.
+   Only collected when the ndlls are built with -Dsamcodeschartboost_profile_bindings, otherwise the profile is always empty.
+**/
+class ChartboostBindingProfile {
+	/**
+	   One line per binding that has been called: "<name>\t<calls>\t<total seconds>\t<max seconds>\t<string bytes>".
+	   String bytes count the UTF-8 string arguments and results marshalled through the binding.
+	**/
+	public static function getProfile():String {
+		return get_binding_profile();
+	}
+	
+	public static function reset():Void {
+		reset_binding_profile();
+	}
+	
+	private static var get_binding_profile = PrimeLoader.load("samcodeschartboost_get_binding_profile", "s");
+	private static var reset_binding_profile = PrimeLoader.load("samcodeschartboost_reset_binding_profile", "v");
+}
+
+#end
\ No newline at end of file
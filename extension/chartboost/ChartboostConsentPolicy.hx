@@ -0,0 +1,14 @@
+package extension.chartboost;
+
+/**
+    Enum for what a consent change does to placements that were requested under the old consent, see Chartboost.setConsentChangePolicy.
+**/
+@:enum abstract ChartboostConsentPolicy(Int) from Int to Int
+{
+	/* Placements requested under the old consent are treated as current. */
+	var KEEP = 0;
+	/* Placements requested or cached under the old consent are marked stale. */
+	var INVALIDATE = 1;
+	/* As INVALIDATE, and stale placements are requested again through ChartboostScheduler once their ad has been shown. */
+	var RECACHE = 2;
+}
\ No newline at end of file
@@ -1,129 +1,77 @@
 package extension.chartboost;
 
 /**
-    Helpers for getting names of errors
-    Note the methods need updating whenever the Chartboost SDK is updated/changes or adds new errors, else there's no guarantee that the mappings to the enums are correct.
+    Helpers for classifying errors and getting their names.
+    The mappings are generated from project/include/ChartboostErrorTable.h, the same table the native code uses. Update that table whenever the Chartboost SDK is updated/changes or adds new errors.
 **/
+@:build(extension.chartboost.ChartboostErrorMacro.buildTables())
 class ChartboostError {
-	#if ios
-	private static function getImpressionErrorDescription(id:Int):String {
-		return switch(id) {
-			case 0:
-				"INTERNAL";
-			case 1:
-				"INTERNET_UNAVAILABLE";
-			case 2:
-				"TOO_MANY_CONNECTIONS";
-			case 3:
-				"WRONG_ORIENTATION";
-			case 4:
-				"FIRST_SESSION_INTERSTITIALS_DISABLED";
-			case 5:
-				"NETWORK_FAILURE";
-			case 6:
-				"NO_AD_FOUND";
-			case 7:
-				"SESSION_NOT_STARTED";
-			case 8:
-				"IMPRESSION_ALREADY_VISIBLE";
-			case 10:
-				"USER_CANCELLATION";
-			case 11:
-				"NO_LOCATION_FOUND";
-			case 16:
-				"ASSET_DOWNLOAD_FAILURE";
-			case 21:
-				"PREFETCHING_INCOMPLETE";
-			case 22:
-				"WEB_VIEW_SCRIPT_ERROR";
-			case 25:
-				"INTERNET_UNAVAILABLE_AT_SHOW";
-			case 33:
-				"AD_PRESENTATION_FAILURE";
-			default:
-				"UNKNOWN CHARTBOOST IMPRESSION ERROR";
-		};
+	/**
+	   Maps an error id passed to a ChartboostListener load/show callback onto a stable error code.
+	**/
+	public static function fromImpressionError(id:Int):ChartboostErrorCode {
+		#if android
+		return lookup(androidImpressionErrors, id);
+		#else
+		return lookup(iosImpressionErrors, id);
+		#end
 	}
 	
-	private static function getClickErrorDescription(id:Int):String {
-		if (id < 0 || id >= orderedClickErrorDescriptions.length) {
-			return "UNKNOWN CHARTBOOST CLICK ERROR";
-		}
-		return orderedClickErrorDescriptions[id];
+	/**
+	   Maps an error id passed to a ChartboostListener click callback onto a stable error code.
+	**/
+	public static function fromClickError(id:Int):ChartboostErrorCode {
+		#if android
+		return lookup(androidClickErrors, id);
+		#else
+		return lookup(iosClickErrors, id);
+		#end
 	}
 	
-	private static var orderedClickErrorDescriptions:Array<String> = [
-		"URI_INVALID",
-		"URI_UNRECOGNIZED",
-		"AGE_GATE_FAILURE",
-		"INTERNAL"
-	];
-	#end
-
-	#if android
-	private static function getImpressionErrorDescription(id:Int):String {
-		if (id < 0 || id >= orderedImpressionErrorDescriptions.length) {
-			return "UNKNOWN CHARTBOOST IMPRESSION ERROR";
-		}
-		return orderedImpressionErrorDescriptions[id];
+	/**
+	   Whether it's worth making the same request again later after this error.
+	**/
+	public static function isRetryable(code:ChartboostErrorCode):Bool {
+		return code >= 0 && code < retryableErrors.length && retryableErrors[code];
 	}
 	
-	private static var orderedImpressionErrorDescriptions:Array<String> = [
-		"INTERNAL",
-		"INTERNET_UNAVAILABLE",
-		"TOO_MANY_CONNECTIONS",
-		"WRONG_ORIENTATION",
-		"FIRST_SESSION_INTERSTITIALS_DISABLED",
-		"NETWORK_FAILURE",
-		"NO_AD_FOUND",
-		"SESSION_NOT_STARTED",
-		"IMPRESSION_ALREADY_VISIBLE",
-		"NO_HOST_ACTIVITY",
-		"USER_CANCELLATION",
-		"INVALID_LOCATION",
-		"VIDEO_UNAVAILABLE",
-		"VIDEO_ID_MISSING",
-		"ERROR_PLAYING_VIDEO",
-		"INVALID_RESPONSE",
-		"ASSETS_DOWNLOAD_FAILURE",
-		"ERROR_CREATING_VIEW",
-		"ERROR_DISPLAYING_VIEW",
-		"INCOMPATIBLE_API_VERSION",
-		"ERROR_LOADING_WEB_VIEW",
-		"ASSET_PREFETCH_IN_PROGRESS",
-		"ACTIVITY_MISSING_IN_MANIFEST",
-		"EMPTY_LOCAL_VIDEO_LIST",
-		"END_POINT_DISABLED",
-		"HARDWARE_ACCELERATION_DISABLED",
-		"PENDING_IMPRESSION_ERROR",
-		"VIDEO_UNAVAILABLE_FOR_CURRENT_ORIENTATION",
-		"ASSET_MISSING",
-		"WEB_VIEW_PAGE_LOAD_TIMEOUT",
-		"WEB_VIEW_CLIENT_RECEIVED_ERROR",
-		"INTERNET_UNAVAILABLE_AT_SHOW"
-	];
-	
-	private static function getClickErrorDescription(id:Int):String {
-		if (id < 0 || id >= orderedClickErrorDescriptions.length) {
-			return "UNKNOWN CHARTBOOST CLICK ERROR";
+	public static function nameOf(code:ChartboostErrorCode):String {
+		if (code < 0 || code >= errorNames.length) {
+			return "UNKNOWN";
 		}
-		return orderedClickErrorDescriptions[id];
+		return errorNames[code];
 	}
 	
-	private static var orderedClickErrorDescriptions:Array<String> = [
-		"URI_INVALID",
-		"URI_UNRECOGNIZED",
-		"AGE_GATE_FAILURE",
-		"NO_HOST_ACTIVITY",
-		"INTERNAL"
-	];
-	#end
-	
 	public static function descriptionForImpressionError(id:Int):String {
-		return getImpressionErrorDescription(id);
+		var code = fromImpressionError(id);
+		return code == ChartboostErrorCode.UNKNOWN ? "UNKNOWN CHARTBOOST IMPRESSION ERROR" : nameOf(code);
 	}
 	
 	public static function descriptionForClickError(id:Int):String {
-		return getClickErrorDescription(id);
+		var code = fromClickError(id);
+		return code == ChartboostErrorCode.UNKNOWN ? "UNKNOWN CHARTBOOST CLICK ERROR" : nameOf(code);
+	}
+	
+	#if ios
+	/**
+	   Number of times the SDK has reported the error since launch or the last resetErrorCounts call.
+	**/
+	public static function getErrorCount(code:ChartboostErrorCode):Int {
+		return get_error_count(code);
+	}
+	
+	public static function resetErrorCounts():Void {
+		reset_error_counts();
+	}
+	
+	private static var get_error_count = PrimeLoader.load("samcodeschartboost_get_error_count", "ii");
+	private static var reset_error_counts = PrimeLoader.load("samcodeschartboost_reset_error_counts", "v");
+	#end
+	
+	private static function lookup(table:Array<Int>, id:Int):ChartboostErrorCode {
+		if (id < 0 || id >= table.length) {
+			return ChartboostErrorCode.UNKNOWN;
+		}
+		return table[id];
 	}
 }
\ No newline at end of file
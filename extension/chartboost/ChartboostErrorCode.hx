@@ -0,0 +1,12 @@
+package extension.chartboost;
+
+/**
+    Stable error codes that the platform specific Chartboost error ids map onto, see ChartboostError.
+    The values are generated from project/include/ChartboostErrorTable.h.
+**/
+@:build(extension.chartboost.ChartboostErrorMacro.buildCodes())
+@:enum abstract ChartboostErrorCode(Int) from Int to Int
+{
+	/* The platform error id isn't in the error table. */
+	var UNKNOWN = -1;
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+package extension.chartboost;
+
+#if macro
+import haxe.io.Path;
+import haxe.macro.Context;
+import haxe.macro.Expr;
+import sys.io.File;
+#end
+
+/**
+   Build macros that generate the Haxe side of the error taxonomy from project/include/ChartboostErrorTable.h, the same table the native code is built from.
+**/
+class ChartboostErrorMacro {
+	#if macro
+	private static var entryPattern = ~/^CHARTBOOST_ERROR\(\s*(\w+)\s*,\s*(-?\d+)\s*,\s*(-?\d+)\s*,\s*(-?\d+)\s*,\s*(-?\d+)\s*,\s*(-?\d+)\s*,\s*(true|false)\s*\)/;
+	
+	/**
+	   Adds a value to ChartboostErrorCode for each entry in the table.
+	**/
+	public static function buildCodes():Array<Field> {
+		var fields = Context.getBuildFields();
+		var pos = Context.currentPos();
+		for (entry in readTable()) {
+			fields.push({ name: entry.name, access: [], kind: FVar(macro:Int, macro $v{entry.id}), pos: pos });
+		}
+		return fields;
+	}
+	
+	/**
+	   Adds the lookup tables used by ChartboostError to classify platform error ids.
+	**/
+	public static function buildTables():Array<Field> {
+		var fields = Context.getBuildFields();
+		var pos = Context.currentPos();
+		
+		var names:Array<String> = [];
+		var retryable:Array<Bool> = [];
+		var iosImpression:Array<Int> = [];
+		var iosClick:Array<Int> = [];
+		var androidImpression:Array<Int> = [];
+		var androidClick:Array<Int> = [];
+		for (entry in readTable()) {
+			names[entry.id] = entry.name;
+			retryable[entry.id] = entry.retryable;
+			addMapping(iosImpression, entry.iosImpression, entry.id);
+			addMapping(iosClick, entry.iosClick, entry.id);
+			addMapping(androidImpression, entry.androidImpression, entry.id);
+			addMapping(androidClick, entry.androidClick, entry.id);
+		}
+		
+		fields.push(makeTable("errorNames", macro:Array<String>, macro $v{names}, pos));
+		fields.push(makeTable("retryableErrors", macro:Array<Bool>, macro $v{retryable}, pos));
+		fields.push(makeTable("iosImpressionErrors", macro:Array<Int>, macro $v{iosImpression}, pos));
+		fields.push(makeTable("iosClickErrors", macro:Array<Int>, macro $v{iosClick}, pos));
+		fields.push(makeTable("androidImpressionErrors", macro:Array<Int>, macro $v{androidImpression}, pos));
+		fields.push(makeTable("androidClickErrors", macro:Array<Int>, macro $v{androidClick}, pos));
+		return fields;
+	}
+	
+	private static function readTable() {
+		var here = Path.directory(Context.getPosInfos(Context.currentPos()).file);
+		var tablePath = Path.join([here, "..", "..", "project", "include", "ChartboostErrorTable.h"]);
+		Context.registerModuleDependency(Context.getLocalModule(), tablePath);
+		
+		var entries = [];
+		for (line in File.getContent(tablePath).split("\n")) {
+			if (!entryPattern.match(StringTools.trim(line))) {
+				continue;
+			}
+			entries.push({
+				name: entryPattern.matched(1),
+				id: Std.parseInt(entryPattern.matched(2)),
+				iosImpression: Std.parseInt(entryPattern.matched(3)),
+				iosClick: Std.parseInt(entryPattern.matched(4)),
+				androidImpression: Std.parseInt(entryPattern.matched(5)),
+				androidClick: Std.parseInt(entryPattern.matched(6)),
+				retryable: entryPattern.matched(7) == "true"
+			});
+		}
+		return entries;
+	}
+	
+	// Platform ids with no entry map to ChartboostErrorCode.UNKNOWN
+	private static function addMapping(table:Array<Int>, platformId:Int, id:Int):Void {
+		if (platformId < 0) {
+			return;
+		}
+		while (table.length <= platformId) {
+			table.push(-1);
+		}
+		table[platformId] = id;
+	}
+	
+	private static function makeTable(name:String, type:ComplexType, values:Expr, pos:Position):Field {
+		return { name: name, access: [APrivate, AStatic], kind: FVar(type, values), pos: pos };
+	}
+	#end
+}
\ No newline at end of file
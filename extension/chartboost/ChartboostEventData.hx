@@ -0,0 +1,20 @@
+package extension.chartboost;
+
+#if ios
+
+/**
+   One slot of the native event ring, read in place. Matches struct ChartboostEvent in SamcodesChartboost.h.
+**/
+@:include("SamcodesChartboost.h")
+@:native("samcodeschartboost::ChartboostEvent")
+@:structAccess
+extern class ChartboostEventData {
+	public var type:Int;
+	public var location:Int;
+	public var error:Int;
+	public var reward:Int;
+	public var status:Int;
+	public var time:Float;
+}
+
+#end
\ No newline at end of file
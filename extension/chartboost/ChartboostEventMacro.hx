@@ -0,0 +1,47 @@
+package extension.chartboost;
+
+#if macro
+import haxe.io.Path;
+import haxe.macro.Context;
+import haxe.macro.Expr;
+import sys.io.File;
+#end
+
+/**
+   Build macro that generates the Haxe event type ids from project/include/ChartboostEventTable.h, the same table the native code is built from.
+**/
+class ChartboostEventMacro {
+	#if macro
+	private static var entryPattern = ~/^CHARTBOOST_EVENT\(\s*(\w+)\s*,\s*(\d+)\s*,\s*(\w+)\s*\)/;
+	
+	/**
+	   Adds a value to ChartboostEventType for each entry in the table.
+	**/
+	public static function buildTypes():Array<Field> {
+		var fields = Context.getBuildFields();
+		var pos = Context.currentPos();
+		for (entry in readTable()) {
+			fields.push({ name: entry.name, access: [], kind: FVar(macro:Int, macro $v{entry.id}), pos: pos });
+		}
+		return fields;
+	}
+	
+	private static function readTable() {
+		var here = Path.directory(Context.getPosInfos(Context.currentPos()).file);
+		var tablePath = Path.join([here, "..", "..", "project", "include", "ChartboostEventTable.h"]);
+		Context.registerModuleDependency(Context.getLocalModule(), tablePath);
+		
+		var entries = [];
+		for (line in File.getContent(tablePath).split("\n")) {
+			if (!entryPattern.match(StringTools.trim(line))) {
+				continue;
+			}
+			entries.push({
+				name: entryPattern.matched(1),
+				id: Std.parseInt(entryPattern.matched(2))
+			});
+		}
+		return entries;
+	}
+	#end
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+package extension.chartboost;
+
+#if ios
+
+/**
+   Reads SDK events in place from the native event ring, with no copies or allocations.
+   Once enabled, events no longer go to the ChartboostListener. Poll the queue once a frame instead:
+   
+   var count = ChartboostEventQueue.available();
+   for (i in 0...count) {
+       var event = ChartboostEventQueue.get(i);
+       switch (event.ref.type) { ... }
+   }
+   ChartboostEventQueue.commit(count);
+   
+   Slots may be overwritten once committed, so don't hold on to the pointers afterwards.
+   If the game falls behind and the ring fills up, new events are dropped and counted.
+**/
+class ChartboostEventQueue {
+	public static function setEnabled(enabled:Bool):Void {
+		set_event_delivery_mode(enabled ? 1 : 0);
+	}
+	
+	/**
+	   The number of events waiting to be read.
+	**/
+	public static inline function available():Int {
+		return ChartboostNative.getEventWriteIndex() - ChartboostNative.getEventReadIndex();
+	}
+	
+	/**
+	   A pointer to the i'th waiting event, where i is less than available().
+	**/
+	public static inline function get(i:Int):cpp.ConstPointer<ChartboostEventData> {
+		var slot = (ChartboostNative.getEventReadIndex() + i) & (ChartboostNative.getEventRingCapacity() - 1);
+		return cpp.ConstPointer.fromRaw(ChartboostNative.getEventRing()).add(slot);
+	}
+	
+	/**
+	   Hands the first count waiting events back to the ring.
+	**/
+	public static inline function commit(count:Int):Void {
+		ChartboostNative.commitEventReadIndex(ChartboostNative.getEventReadIndex() + count);
+	}
+	
+	/**
+	   The name of an event's location. This allocates a Haxe string, so compare location indices from ChartboostLocationStates.getIndex where you can.
+	**/
+	public static function getLocationName(location:Int):String {
+		return location < 0 ? "" : cast ChartboostNative.getLocationName(location);
+	}
+	
+	public static function getDroppedCount():Int {
+		return get_dropped_event_count();
+	}
+	
+	private static var set_event_delivery_mode = PrimeLoader.load("samcodeschartboost_set_event_delivery_mode", "iv");
+	private static var get_dropped_event_count = PrimeLoader.load("samcodeschartboost_get_dropped_event_count", "i");
+}
+
+#end
\ No newline at end of file
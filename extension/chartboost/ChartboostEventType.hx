@@ -0,0 +1,10 @@
+package extension.chartboost;
+
+/**
+    Enum for the types of event the extension delivers. See ChartboostEventQueue.
+    The values are generated from project/include/ChartboostEventTable.h.
+**/
+@:build(extension.chartboost.ChartboostEventMacro.buildTypes())
+@:enum abstract ChartboostEventType(Int) from Int to Int
+{
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+package extension.chartboost;
+
+#if ios
+
+import haxe.io.Bytes;
+
+/**
+   A Chartboost InPlay native ad, for building ad placements into your own UI.
+   The icon is handed over as a view of the native bytes rather than a copy. Views returned by getIcon and getIconPixels are only valid until dispose is called.
+**/
+class ChartboostInPlay {
+	public static function cache(location:String):Void {
+		cache_in_play(location);
+	}
+	
+	public static function has(location:String):Bool {
+		return has_in_play(location);
+	}
+	
+	/**
+	   Gets a cached InPlay ad for the location, or null if there isn't one yet.
+	**/
+	public static function get(location:String):ChartboostInPlay {
+		var handle = get_in_play(location);
+		return handle == 0 ? null : new ChartboostInPlay(handle);
+	}
+	
+	public var appName(default, null):String;
+	
+	private var handle:Int;
+	
+	private function new(handle:Int) {
+		this.handle = handle;
+		appName = get_in_play_app_name(handle);
+	}
+	
+	/**
+	   The encoded icon image, as a view of the native bytes.
+	**/
+	public function getIcon():Bytes {
+		return view(ChartboostNative.getInPlayIconData(handle), get_in_play_icon_length(handle));
+	}
+	
+	/**
+	   Starts decoding the icon into premultiplied RGBA pixels on a background thread. Poll isIconDecoded to find out when it's done.
+	**/
+	public function decodeIcon():Void {
+		decode_in_play_icon(handle);
+	}
+	
+	public function isIconDecoded():Bool {
+		return is_in_play_icon_decoded(handle);
+	}
+	
+	/**
+	   The decoded icon as premultiplied RGBA, 4 bytes per pixel, rows top to bottom. Null until isIconDecoded returns true.
+	**/
+	public function getIconPixels():Bytes {
+		if (!isIconDecoded()) {
+			return null;
+		}
+		return view(ChartboostNative.getInPlayIconPixels(handle), getIconWidth() * getIconHeight() * 4);
+	}
+	
+	public function getIconWidth():Int {
+		return get_in_play_icon_width(handle);
+	}
+	
+	public function getIconHeight():Int {
+		return get_in_play_icon_height(handle);
+	}
+	
+	/**
+	   Marks the ad as shown, call this when it appears on screen.
+	**/
+	public function show():Void {
+		show_in_play(handle);
+	}
+	
+	/**
+	   Marks the ad as clicked and opens the advertised app.
+	**/
+	public function click():Void {
+		click_in_play(handle);
+	}
+	
+	/**
+	   Clears all cached InPlay ads in the SDK.
+	**/
+	public function clearCache():Void {
+		clear_in_play_cache(handle);
+	}
+	
+	/**
+	   Releases the native handle, along with the icon and pixel memory. Bytes views from this ad must not be used afterwards.
+	**/
+	public function dispose():Void {
+		release_in_play(handle);
+		handle = 0;
+	}
+	
+	private static function view(data:cpp.RawConstPointer<cpp.UInt8>, length:Int):Bytes {
+		if (data == null || length <= 0) {
+			return null;
+		}
+		var array:Array<cpp.UInt8> = [];
+		cpp.NativeArray.setUnmanagedData(array, cpp.ConstPointer.fromRaw(data), length);
+		return Bytes.ofData(array);
+	}
+	
+	private static var cache_in_play = PrimeLoader.load("samcodeschartboost_cache_in_play", "sv");
+	private static var has_in_play = PrimeLoader.load("samcodeschartboost_has_in_play", "sb");
+	private static var get_in_play = PrimeLoader.load("samcodeschartboost_get_in_play", "si");
+	private static var release_in_play = PrimeLoader.load("samcodeschartboost_release_in_play", "iv");
+	private static var get_in_play_app_name = PrimeLoader.load("samcodeschartboost_get_in_play_app_name", "is");
+	private static var get_in_play_icon_length = PrimeLoader.load("samcodeschartboost_get_in_play_icon_length", "ii");
+	private static var decode_in_play_icon = PrimeLoader.load("samcodeschartboost_decode_in_play_icon", "iv");
+	private static var is_in_play_icon_decoded = PrimeLoader.load("samcodeschartboost_is_in_play_icon_decoded", "ib");
+	private static var get_in_play_icon_width = PrimeLoader.load("samcodeschartboost_get_in_play_icon_width", "ii");
+	private static var get_in_play_icon_height = PrimeLoader.load("samcodeschartboost_get_in_play_icon_height", "ii");
+	private static var show_in_play = PrimeLoader.load("samcodeschartboost_show_in_play", "iv");
+	private static var click_in_play = PrimeLoader.load("samcodeschartboost_click_in_play", "iv");
+	private static var clear_in_play_cache = PrimeLoader.load("samcodeschartboost_clear_in_play_cache", "iv");
+}
+
+#end
\ No newline at end of file
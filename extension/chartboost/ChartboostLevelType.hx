@@ -0,0 +1,19 @@
+package extension.chartboost;
+
+/**
+    Enum describing what a tracked level value means in the game's context, see Chartboost.trackLevelInfo.
+    Note this enum needs updating whenever the Chartboost SDK is updated/changes or adds new level types, else there's no guarantee that the mapping here is correct.
+**/
+@:enum abstract ChartboostLevelType(Int) from Int to Int
+{
+	/* Highest level reached. */
+	var HIGHEST_LEVEL_REACHED = 1;
+	/* Current area level reached. */
+	var CURRENT_AREA = 2;
+	/* Current character level reached. */
+	var CHARACTER_LEVEL = 3;
+	/* Other sequential level reached. */
+	var OTHER_SEQUENTIAL = 4;
+	/* Current non sequential level reached. */
+	var OTHER_NONSEQUENTIAL = 5;
+}
\ No newline at end of file
@@ -86,6 +86,22 @@ class ChartboostListener {
 		
 	}
 	
+	public function didCacheBanner(location:String, error:Int):Void {
+		
+	}
+	
+	public function willShowBanner(location:String, error:Int):Void {
+		
+	}
+	
+	public function didShowBanner(location:String, error:Int):Void {
+		
+	}
+	
+	public function didClickBanner(location:String, error:Int):Void {
+		
+	}
+	
 	// TODO there are far better ways of doing this
 	#if ios
 	// Interstitial events
@@ -111,10 +127,76 @@ class ChartboostListener {
 	
 	private static inline var WILL_DISPLAY_VIDEO:String = "willDisplayVideo";
 	
+	// Banner events
+	private static inline var DID_CACHE_BANNER:String = "didCacheBanner";
+	private static inline var WILL_SHOW_BANNER:String = "willShowBanner";
+	private static inline var DID_SHOW_BANNER:String = "didShowBanner";
+	private static inline var DID_CLICK_BANNER:String = "didClickBanner";
+	
 	// Misc
 	private static inline var DID_FAIL_TO_RECORD_CLICK:String = "didFailToRecordClick";
 	private static inline var DID_INITIALIZE:String = "didInitialize";
 	
+	/**
+	   Typed dispatch for events delivered through ChartboostListeners.
+	**/
+	public function notifyEvent(type:ChartboostEventType, location:String, error:Int, reward:Int, status:Bool):Void {
+		switch(type) {
+			case ChartboostEventType.SHOULD_REQUEST_INTERSTITIAL:
+				shouldRequestInterstitial(location);
+			case ChartboostEventType.SHOULD_DISPLAY_INTERSTITIAL:
+				shouldDisplayInterstitial(location);
+			case ChartboostEventType.DID_CACHE_INTERSTITIAL:
+				didCacheInterstitial(location);
+			case ChartboostEventType.DID_FAIL_TO_LOAD_INTERSTITIAL:
+				didFailToLoadInterstitial(location, error);
+			case ChartboostEventType.DID_DISMISS_INTERSTITIAL:
+				didDismissInterstitial(location);
+			case ChartboostEventType.DID_CLOSE_INTERSTITIAL:
+				didCloseInterstitial(location);
+			case ChartboostEventType.DID_CLICK_INTERSTITIAL:
+				didClickInterstitial(location);
+			case ChartboostEventType.DID_DISPLAY_INTERSTITIAL:
+				didDisplayInterstitial(location);
+				
+			case ChartboostEventType.SHOULD_DISPLAY_REWARDED_VIDEO:
+				shouldDisplayRewardedVideo(location);
+			case ChartboostEventType.DID_CACHE_REWARDED_VIDEO:
+				didCacheRewardedVideo(location);
+			case ChartboostEventType.DID_FAIL_TO_LOAD_REWARDED_VIDEO:
+				didFailToLoadRewardedVideo(location, error);
+			case ChartboostEventType.DID_DISMISS_REWARDED_VIDEO:
+				didDismissRewardedVideo(location);
+			case ChartboostEventType.DID_CLOSE_REWARDED_VIDEO:
+				didCloseRewardedVideo(location);
+			case ChartboostEventType.DID_CLICK_REWARDED_VIDEO:
+				didClickRewardedVideo(location);
+			case ChartboostEventType.DID_COMPLETE_REWARDED_VIDEO:
+				didCompleteRewardedVideo(location, reward);
+			case ChartboostEventType.DID_DISPLAY_REWARDED_VIDEO:
+				didDisplayRewardedVideo(location);
+				
+			case ChartboostEventType.WILL_DISPLAY_VIDEO:
+				willDisplayVideo(location);
+				
+			case ChartboostEventType.DID_CACHE_BANNER:
+				didCacheBanner(location, error);
+			case ChartboostEventType.WILL_SHOW_BANNER:
+				willShowBanner(location, error);
+			case ChartboostEventType.DID_SHOW_BANNER:
+				didShowBanner(location, error);
+			case ChartboostEventType.DID_CLICK_BANNER:
+				didClickBanner(location, error);
+				
+			case ChartboostEventType.DID_FAIL_TO_RECORD_CLICK:
+				didFailToRecordClick("", error);
+			case ChartboostEventType.DID_INITIALIZE:
+				didInitialize(status);
+				
+			default:
+		}
+	}
+	
 	public function notify(inEvent:Dynamic):Void {
 		var type:String = "";
 		var location:String = "";
@@ -187,6 +269,15 @@ class ChartboostListener {
 			case WILL_DISPLAY_VIDEO:
 				willDisplayVideo(location);
 				
+			case DID_CACHE_BANNER:
+				didCacheBanner(location, error);
+			case WILL_SHOW_BANNER:
+				willShowBanner(location, error);
+			case DID_SHOW_BANNER:
+				didShowBanner(location, error);
+			case DID_CLICK_BANNER:
+				didClickBanner(location, error);
+				
 			case DID_FAIL_TO_RECORD_CLICK:
 				didFailToRecordClick(uri, error);
 			case DID_INITIALIZE:
@@ -0,0 +1,77 @@
+package extension.chartboost;
+
+#if ios
+
+import haxe.ds.IntMap;
+
+/**
+   Fans SDK events out to any number of listeners, each with its own event mask and priority, in place of Chartboost.setListener.
+   Events are marshalled once natively and passed to each interested listener through a plain function pointer, highest priority first.
+   Adding the first listener takes over event delivery, removing the last one hands it back to the event queue, event callback or listener that had it.
+**/
+class ChartboostListeners {
+	public static inline var ALL_EVENTS:Int = -1;
+	
+	/**
+	   Builds a mask that subscribes to the given event types.
+	**/
+	public static function maskOf(types:Array<ChartboostEventType>):Int {
+		var mask = 0;
+		for (type in types) {
+			mask |= 1 << type;
+		}
+		return mask;
+	}
+	
+	/**
+	   Returns an id for removing the listener later, or -1 if too many listeners are registered.
+	**/
+	public static function add(listener:ChartboostListener, mask:Int = ALL_EVENTS, priority:Int = 0):Int {
+		if (!callbackSet) {
+			ChartboostNative.setListenerCallback(cpp.Callable.fromStaticFunction(dispatch));
+			callbackSet = true;
+		}
+		var id = ChartboostNative.addListener(mask, priority);
+		if (id >= 0) {
+			listeners.set(id, listener);
+		}
+		return id;
+	}
+	
+	public static function remove(id:Int):Void {
+		ChartboostNative.removeListener(id);
+		listeners.remove(id);
+	}
+	
+	public static function setMask(id:Int, mask:Int):Void {
+		ChartboostNative.setListenerMask(id, mask);
+	}
+	
+	private static var listeners = new IntMap<ChartboostListener>();
+	private static var callbackSet:Bool = false;
+	
+	// Location names are looked up once per location, rather than once per event
+	private static var locationNames:Array<String> = [];
+	
+	private static function dispatch(id:Int, type:Int, location:Int, error:Int, reward:Int, status:Bool):Void {
+		var listener = listeners.get(id);
+		if (listener == null) {
+			return;
+		}
+		listener.notifyEvent(type, getLocationName(location), error, reward, status);
+	}
+	
+	private static function getLocationName(location:Int):String {
+		if (location < 0) {
+			return "";
+		}
+		var name = locationNames[location];
+		if (name == null) {
+			name = ChartboostEventQueue.getLocationName(location);
+			locationNames[location] = name;
+		}
+		return name;
+	}
+}
+
+#end
\ No newline at end of file
@@ -0,0 +1,22 @@
+package extension.chartboost;
+
+/**
+    Enum for the lifecycle states the native layer tracks for each location, see ChartboostLocationStates.
+**/
+@:enum abstract ChartboostLocationState(Int) from Int to Int
+{
+	/* Nothing has happened at the location yet. */
+	var IDLE = 0;
+	/* A cache request is in progress. */
+	var REQUESTING = 1;
+	/* An ad is cached and ready to show. */
+	var CACHED = 2;
+	/* The SDK is about to display an ad. */
+	var SHOWING = 3;
+	/* An ad is on screen. */
+	var DISPLAYED = 4;
+	/* The ad was dismissed or closed. */
+	var CLOSED = 5;
+	/* The last cache or show attempt failed. */
+	var FAILED = 6;
+}
\ No newline at end of file
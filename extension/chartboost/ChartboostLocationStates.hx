@@ -0,0 +1,57 @@
+package extension.chartboost;
+
+#if ios
+
+/**
+   Per-location lifecycle state, kept natively and advanced straight from the SDK delegate callbacks.
+   Look up a location's index once with getIndex, after which getState is a single native array read.
+   Time spent in each state is accumulated into dwell-time histograms, with buckets by powers of two milliseconds.
+**/
+class ChartboostLocationStates {
+	public static inline var DWELL_BUCKET_COUNT:Int = 20;
+	
+	/**
+	   The index for a location, or -1 if too many distinct locations are in use.
+	**/
+	public static function getIndex(location:String):Int {
+		return get_location_index(location);
+	}
+	
+	public static function getState(type:ChartboostAdType, index:Int):ChartboostLocationState {
+		return get_location_state(type, index);
+	}
+	
+	/**
+	   Total seconds the location has spent in a state, not counting the time in its current state.
+	**/
+	public static function getDwellTime(type:ChartboostAdType, index:Int, state:ChartboostLocationState):Float {
+		return get_location_dwell_time(type, index, state);
+	}
+	
+	/**
+	   How many stays in the state fell into each dwell time bucket, across all locations. Bucket 0 is under 1ms, bucket n is 2^(n-1) to 2^n ms and the last bucket is open ended.
+	**/
+	public static function getDwellHistogram(type:ChartboostAdType, state:ChartboostLocationState):Array<Int> {
+		return [for (bucket in 0...DWELL_BUCKET_COUNT) get_dwell_histogram_count(type, state, bucket)];
+	}
+	
+	/**
+	   How many delegate callbacks moved a location between states in an unexpected order.
+	**/
+	public static function getIllegalTransitionCount():Int {
+		return get_illegal_transition_count();
+	}
+	
+	public static function resetStats():Void {
+		reset_location_stats();
+	}
+	
+	private static var get_location_index = PrimeLoader.load("samcodeschartboost_get_location_index", "si");
+	private static var get_location_state = PrimeLoader.load("samcodeschartboost_get_location_state", "iii");
+	private static var get_location_dwell_time = PrimeLoader.load("samcodeschartboost_get_location_dwell_time", "iiid");
+	private static var get_dwell_histogram_count = PrimeLoader.load("samcodeschartboost_get_dwell_histogram_count", "iiii");
+	private static var get_illegal_transition_count = PrimeLoader.load("samcodeschartboost_get_illegal_transition_count", "i");
+	private static var reset_location_stats = PrimeLoader.load("samcodeschartboost_reset_location_stats", "v");
+}
+
+#end
\ No newline at end of file
@@ -0,0 +1,38 @@
+package extension.chartboost;
+
+#if ios
+
+/**
+   Resident memory of the process, sampled before init, once the SDK has initialized, and around each placement's caches and shows, for sizing the prefetch set to a memory budget.
+   A cache is charged the change from its request to the SDK caching it, and a close the change from the SDK starting to display the ad to it closing. Memory the game allocated in those windows is counted too, so average over many caches before drawing conclusions.
+   The same numbers are included in ChartboostMetrics.
+**/
+class ChartboostMemory {
+	/**
+	   Resident memory of the process right now in bytes, or -1 if it can't be read.
+	**/
+	public static function getResidentMemory():Float {
+		return get_resident_memory();
+	}
+	
+	/**
+	   "init\t<bytes before>\t<bytes after>" and "resident\t<last sampled bytes>\t<peak sampled bytes>" lines, where -1 means not sampled yet.
+	   These are followed by a "<ad type>\t<location>\t<caches>\t<cache bytes>\t<closes>\t<close bytes>" line per placement, with bytes summed over its samples.
+	**/
+	public static function getReport():String {
+		return get_memory_report();
+	}
+	
+	/**
+	   Clears the per placement attribution and the resident samples. The init samples are kept.
+	**/
+	public static function reset():Void {
+		reset_memory_stats();
+	}
+	
+	private static var get_resident_memory = PrimeLoader.load("samcodeschartboost_get_resident_memory", "d");
+	private static var get_memory_report = PrimeLoader.load("samcodeschartboost_get_memory_report", "s");
+	private static var reset_memory_stats = PrimeLoader.load("samcodeschartboost_reset_memory_stats", "v");
+}
+
+#end
\ No newline at end of file
@@ -0,0 +1,33 @@
+package extension.chartboost;
+
+#if ios
+
+/**
+   Exports the native stats in OpenMetrics (Prometheus) text format: error counts, dropped events, SDK stalls, per-location states and dwell times, dwell time histograms, and the ChartboostScheduler queue depth, retries and timeouts.
+   The export runs on a background thread, which replaces the file atomically so a scraper never reads a partly written one.
+**/
+class ChartboostMetrics {
+	/**
+	   Starts writing the metrics to the file at path every interval seconds. The path must be writable by the app, e.g. in the documents or caches directory.
+	**/
+	public static function startExport(path:String, interval:Float):Void {
+		start_metrics_export(path, interval);
+	}
+	
+	public static function stopExport():Void {
+		stop_metrics_export();
+	}
+	
+	/**
+	   The current metrics, serialized on the calling thread.
+	**/
+	public static function getText():String {
+		return get_open_metrics_text();
+	}
+	
+	private static var start_metrics_export = PrimeLoader.load("samcodeschartboost_start_metrics_export", "sdv");
+	private static var stop_metrics_export = PrimeLoader.load("samcodeschartboost_stop_metrics_export", "v");
+	private static var get_open_metrics_text = PrimeLoader.load("samcodeschartboost_get_open_metrics_text", "s");
+}
+
+#end
\ No newline at end of file
@@ -0,0 +1,62 @@
+package extension.chartboost;
+
+#if ios
+
+/**
+   Direct calls into the native side of the extension, for data that is read in place rather than marshalled through CFFI.
+   The pointers returned here point into memory owned by the extension, see the notes on each function for how long they stay valid.
+**/
+@:include("SamcodesChartboost.h")
+@:include("ChartboostLocations.h")
+@:buildXml('<files id="haxe"><compilerflag value="-I${haxelib:samcodes-chartboost}/project/include"/></files>')
+extern class ChartboostNative {
+	/* Valid until the InPlay handle is released. */
+	@:native("samcodeschartboost::getInPlayIconData")
+	public static function getInPlayIconData(handle:Int):cpp.RawConstPointer<cpp.UInt8>;
+	
+	/* Valid until the InPlay handle is released. Null until the icon has been decoded. */
+	@:native("samcodeschartboost::getInPlayIconPixels")
+	public static function getInPlayIconPixels(handle:Int):cpp.RawConstPointer<cpp.UInt8>;
+	
+	/* The event ring's slots, valid for the lifetime of the process. See ChartboostEventQueue. */
+	@:native("samcodeschartboost::getEventRing")
+	public static function getEventRing():cpp.RawConstPointer<ChartboostEventData>;
+	
+	@:native("samcodeschartboost::getEventRingCapacity")
+	public static function getEventRingCapacity():Int;
+	
+	@:native("samcodeschartboost::getEventWriteIndex")
+	public static function getEventWriteIndex():Int;
+	
+	@:native("samcodeschartboost::getEventReadIndex")
+	public static function getEventReadIndex():Int;
+	
+	@:native("samcodeschartboost::commitEventReadIndex")
+	public static function commitEventReadIndex(index:Int):Void;
+	
+	/* Called on the main thread with (type, location, error, reward, status) in place of the listener. */
+	@:native("samcodeschartboost::setEventCallback")
+	public static function setEventCallback(callback:cpp.Callable<Int->Int->Int->Int->Bool->Void>):Void;
+	
+	@:native("samcodeschartboost::clearEventCallback")
+	public static function clearEventCallback():Void;
+	
+	/* Called on the main thread with (listener, type, location, error, reward, status) for each listener interested in an event. See ChartboostListeners. */
+	@:native("samcodeschartboost::setListenerCallback")
+	public static function setListenerCallback(callback:cpp.Callable<Int->Int->Int->Int->Int->Bool->Void>):Void;
+	
+	@:native("samcodeschartboost::addListener")
+	public static function addListener(mask:Int, priority:Int):Int;
+	
+	@:native("samcodeschartboost::removeListener")
+	public static function removeListener(listener:Int):Void;
+	
+	@:native("samcodeschartboost::setListenerMask")
+	public static function setListenerMask(listener:Int, mask:Int):Void;
+	
+	/* Valid for the lifetime of the process. */
+	@:native("samcodeschartboost::getLocationName")
+	public static function getLocationName(index:Int):cpp.ConstCharStar;
+}
+
+#end
\ No newline at end of file
@@ -0,0 +1,51 @@
+package extension.chartboost;
+
+#if ios
+
+/**
+   Pre-caches placements just before the game is expected to show them, based on progression steps you report (a level finished, the player died).
+   It measures how long steps and cache requests take, and asks ChartboostScheduler to cache a placement early enough to be ready for its next show.
+   Only watched placements are ever requested, and each stops being requested once it has used up its shows for the session.
+   Requests are issued from ChartboostScheduler.update.
+**/
+class ChartboostPredictor {
+	/**
+	   @param stepsPerShow How many progression steps there are between shows of the placement, e.g. 3 for an interstitial every third death.
+	   @param maxShows The most times the placement will be shown this session, or 0 for no limit.
+	**/
+	public static function watch(type:ChartboostAdType, location:String, stepsPerShow:Int, maxShows:Int = 0):Void {
+		watch_placement(type, location, stepsPerShow, maxShows);
+	}
+	
+	public static function unwatch(type:ChartboostAdType, location:String):Void {
+		unwatch_placement(type, location);
+	}
+	
+	public static function reportStep(type:ChartboostAdType, location:String):Void {
+		report_progress_step(type, location);
+	}
+	
+	/**
+	   Predicted seconds until the placement is next shown, or -1 if there's no prediction.
+	**/
+	public static function getTimeToShow(type:ChartboostAdType, location:String):Float {
+		return get_time_to_show(type, location);
+	}
+	
+	/**
+	   @param safetyFactor How many observed cache times ahead of a predicted show to request the placement.
+	   @param defaultCacheTime Seconds assumed to cache a placement before any cache has been timed.
+	   @param smoothing Weight of the newest sample in the step and cache time averages.
+	**/
+	public static function setPolicy(safetyFactor:Float = 2.0, defaultCacheTime:Float = 5.0, smoothing:Float = 0.3):Void {
+		set_predictor_policy(safetyFactor, defaultCacheTime, smoothing);
+	}
+	
+	private static var watch_placement = PrimeLoader.load("samcodeschartboost_watch_placement", "isiiv");
+	private static var unwatch_placement = PrimeLoader.load("samcodeschartboost_unwatch_placement", "isv");
+	private static var report_progress_step = PrimeLoader.load("samcodeschartboost_report_progress_step", "isv");
+	private static var get_time_to_show = PrimeLoader.load("samcodeschartboost_get_time_to_show", "isd");
+	private static var set_predictor_policy = PrimeLoader.load("samcodeschartboost_set_predictor_policy", "dddv");
+}
+
+#end
\ No newline at end of file
@@ -0,0 +1,61 @@
+package extension.chartboost;
+
+#if ios
+
+/**
+   Schedules cache requests around hints from the game, so ads load during loading screens, menus and pauses instead of during gameplay.
+   Non-urgent requests wait for an idle window and go out a few at a time. Urgent requests are issued straight away.
+   Call update regularly (e.g. once a frame).
+**/
+class ChartboostScheduler {
+	public static function request(type:ChartboostAdType, location:String, urgent:Bool = false):Void {
+		request_cache(type, location, urgent);
+	}
+	
+	/**
+	   Marks the start of a stretch where loading ads won't hurt, like a loading screen or menu. Windows can be nested.
+	**/
+	public static function beginIdleWindow():Void {
+		begin_idle_window();
+	}
+	
+	public static function endIdleWindow():Void {
+		end_idle_window();
+	}
+	
+	/**
+	   Handles timeouts and retries, and issues the requests ChartboostPredictor has found to be due.
+	**/
+	public static function update():Void {
+		update_scheduler();
+	}
+	
+	/**
+	   @param maxInFlight Non-urgent requests allowed in flight at once.
+	   @param maxRetries Retries after a retryable load error or a timeout.
+	   @param retryBackoff Seconds before the first retry, doubling after that.
+	   @param requestTimeout Seconds before an unanswered request is retried.
+	   @param deferOutsideIdle Whether non-urgent requests wait for an idle window.
+	**/
+	public static function setPolicy(maxInFlight:Int = 1, maxRetries:Int = 3, retryBackoff:Float = 5.0, requestTimeout:Float = 30.0, deferOutsideIdle:Bool = true):Void {
+		set_scheduler_policy(maxInFlight, maxRetries, retryBackoff, requestTimeout, deferOutsideIdle);
+	}
+	
+	public static function getPendingCount():Int {
+		return get_scheduler_pending_count();
+	}
+	
+	public static function getInFlightCount():Int {
+		return get_scheduler_in_flight_count();
+	}
+	
+	private static var request_cache = PrimeLoader.load("samcodeschartboost_request_cache", "isbv");
+	private static var begin_idle_window = PrimeLoader.load("samcodeschartboost_begin_idle_window", "v");
+	private static var end_idle_window = PrimeLoader.load("samcodeschartboost_end_idle_window", "v");
+	private static var update_scheduler = PrimeLoader.load("samcodeschartboost_update_scheduler", "v");
+	private static var set_scheduler_policy = PrimeLoader.load("samcodeschartboost_set_scheduler_policy", "iiddbv");
+	private static var get_scheduler_pending_count = PrimeLoader.load("samcodeschartboost_get_scheduler_pending_count", "i");
+	private static var get_scheduler_in_flight_count = PrimeLoader.load("samcodeschartboost_get_scheduler_in_flight_count", "i");
+}
+
+#end
\ No newline at end of file
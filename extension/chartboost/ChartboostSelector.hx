@@ -0,0 +1,40 @@
+package extension.chartboost;
+
+#if ios
+
+/**
+   Chooses between interchangeable placements, e.g. several interstitial locations that could be shown at the same point in the game.
+   It learns from every cache request which placements fill reliably and quickly (a UCB1 bandit) and picks the best, while still trying the others now and then.
+**/
+class ChartboostSelector {
+	public static function addCandidate(group:String, type:ChartboostAdType, location:String):Void {
+		add_selector_candidate(group, type, location);
+	}
+	
+	public static function clearGroup(group:String):Void {
+		clear_selector_group(group);
+	}
+	
+	/**
+	   Returns the best location in the group, or null if the group has no candidates.
+	**/
+	public static function select(group:String):String {
+		var location:String = select_placement(group);
+		return location == "" ? null : location;
+	}
+	
+	/**
+	   @param latencyScale Seconds of cache time at which a fill counts for half as much as an instant one.
+	   @param exploration How strongly less tried placements are favoured.
+	**/
+	public static function setParams(latencyScale:Float = 5.0, exploration:Float = 1.41421356):Void {
+		set_selector_params(latencyScale, exploration);
+	}
+	
+	private static var add_selector_candidate = PrimeLoader.load("samcodeschartboost_add_selector_candidate", "sisv");
+	private static var clear_selector_group = PrimeLoader.load("samcodeschartboost_clear_selector_group", "sv");
+	private static var select_placement = PrimeLoader.load("samcodeschartboost_select_placement", "ss");
+	private static var set_selector_params = PrimeLoader.load("samcodeschartboost_set_selector_params", "ddv");
+}
+
+#end
\ No newline at end of file
@@ -0,0 +1,67 @@
+package extension.chartboost;
+
+#if ios
+
+/**
+   Times every call the extension makes into the Chartboost SDK on the main thread.
+   Calls over the stall threshold are counted and recorded with their name and location in the flight recorder.
+   The optional watchdog thread also records calls that still haven't returned after the hang threshold, so hangs show up even if the call never comes back.
+**/
+class ChartboostStallWatchdog {
+	/**
+	   Calls taking longer than this many seconds are recorded as stalls, 16ms by default.
+	**/
+	public static function setStallThreshold(seconds:Float):Void {
+		set_stall_threshold(seconds);
+	}
+	
+	public static function start(hangThreshold:Float):Void {
+		start_stall_watchdog(hangThreshold);
+	}
+	
+	public static function stop():Void {
+		stop_stall_watchdog();
+	}
+	
+	public static function getCallCount():Int {
+		return get_sdk_call_count();
+	}
+	
+	public static function getStallCount():Int {
+		return get_stall_count();
+	}
+	
+	public static function getHangCount():Int {
+		return get_hang_count();
+	}
+	
+	/**
+	   The longest stall seen, in seconds.
+	**/
+	public static function getMaxStallDuration():Float {
+		return get_max_stall_duration();
+	}
+	
+	public static function resetStats():Void {
+		reset_stall_stats();
+	}
+	
+	/**
+	   The recent stalls and hangs, one per line and oldest first: "<time> <stall|hang> <call> <location> <seconds>".
+	**/
+	public static function getFlightRecorderDump():String {
+		return get_flight_recorder_dump();
+	}
+	
+	private static var set_stall_threshold = PrimeLoader.load("samcodeschartboost_set_stall_threshold", "dv");
+	private static var start_stall_watchdog = PrimeLoader.load("samcodeschartboost_start_stall_watchdog", "dv");
+	private static var stop_stall_watchdog = PrimeLoader.load("samcodeschartboost_stop_stall_watchdog", "v");
+	private static var get_sdk_call_count = PrimeLoader.load("samcodeschartboost_get_sdk_call_count", "i");
+	private static var get_stall_count = PrimeLoader.load("samcodeschartboost_get_stall_count", "i");
+	private static var get_hang_count = PrimeLoader.load("samcodeschartboost_get_hang_count", "i");
+	private static var get_max_stall_duration = PrimeLoader.load("samcodeschartboost_get_max_stall_duration", "d");
+	private static var reset_stall_stats = PrimeLoader.load("samcodeschartboost_reset_stall_stats", "v");
+	private static var get_flight_recorder_dump = PrimeLoader.load("samcodeschartboost_get_flight_recorder_dump", "s");
+}
+
+#end
\ No newline at end of file
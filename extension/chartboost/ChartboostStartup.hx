@@ -0,0 +1,29 @@
+package extension.chartboost;
+
+#if ios
+
+/**
+   Timestamps of what the extension does at launch, for seeing what it costs and catching regressions when the SDK is upgraded.
+**/
+class ChartboostStartup {
+	@:noCompletion public static inline var PRIME_LOADER_INIT:Int = 1;
+	@:noCompletion public static inline var BINDINGS_RESOLVED:Int = 2;
+	
+	/**
+	   One line per milestone reached, in seconds since the ndll loaded: ndll_loaded, prime_loader_init, bindings_resolved (the last binding of any class loaded), init_enter, init_exit, sdk_started (startWithAppId returned) and did_initialize.
+	   The ndll is linked statically on iOS, so its static initializers run before Haxe boots and prime_loader_init comes out positive.
+	   These are followed by a "first_cache\t<ad type>\t<location>\t<seconds>" line for the first successful cache of each placement.
+	**/
+	public static function getReport():String {
+		// Static initialization is long over by the time anyone asks, so every class has loaded its bindings
+		var now = haxe.Timer.stamp();
+		mark_startup_milestone(PRIME_LOADER_INIT, now - PrimeLoader.initTime);
+		mark_startup_milestone(BINDINGS_RESOLVED, now - PrimeLoader.lastLoadTime);
+		return get_startup_report();
+	}
+	
+	private static var get_startup_report = PrimeLoader.load("samcodeschartboost_get_startup_report", "s");
+	private static var mark_startup_milestone = PrimeLoader.load("samcodeschartboost_mark_startup_milestone", "idv");
+}
+
+#end
\ No newline at end of file
@@ -11,12 +11,28 @@ import haxe.macro.Expr;
 **/
 class PrimeLoader {
 	#if cpp
+	/**
+	   When __init__ ran, for the startup report. Set before static initialization, so it has no initializer of its own.
+	**/
+	public static var initTime:Float;
+	
 	public static function __init__() {
+		initTime = haxe.Timer.stamp();
 		cpp.Lib.pushDllSearchPath("project/ndll/" + cpp.Lib.getBinDirectory());
 	}
+	
+	/**
+	   When the most recent binding was loaded, in any class, for the startup report. Set during static initialization, so it has no initializer of its own.
+	**/
+	public static var lastLoadTime:Float;
+	
+	@:noCompletion public static inline function loaded<T>(binding:T):T {
+		lastLoadTime = haxe.Timer.stamp();
+		return binding;
+	}
 	#end
 	
 	public static inline macro function load(inName2:Expr, inSig:Expr) {
-		return macro cpp.Prime.load("samcodeschartboost", $inName2, $inSig, false);
+		return macro extension.chartboost.PrimeLoader.loaded(cpp.Prime.load("samcodeschartboost", $inName2, $inSig, false));
 	}
 }
\ No newline at end of file
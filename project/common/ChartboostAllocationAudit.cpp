@@ -0,0 +1,228 @@
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+
+#include "ChartboostAllocationAudit.h"
+#include "ChartboostBindingProfiler.h"
+#include "ChartboostText.h"
+#include "SamcodesChartboost.h"
+
+namespace samcodeschartboost
+{
+	namespace
+	{
+		// Bindings first, then event types
+		const int SCOPE_COUNT = MAX_PROFILED_BINDINGS + EVENT_TYPE_COUNT;
+		
+		struct ScopeCounts
+		{
+			std::atomic<long long> calls;
+			std::atomic<long long> allocations[ALLOCATION_KIND_COUNT];
+			std::atomic<long long> bytes[ALLOCATION_KIND_COUNT];
+		};
+		
+		ScopeCounts scopeCounts[SCOPE_COUNT];
+		
+		// Plain int so reading it from operator new can't itself allocate
+		thread_local int currentScope = -1;
+		
+		int getScope(int kind, int id)
+		{
+			if(kind == ALLOCATION_SCOPE_BINDING && id >= 0 && id < MAX_PROFILED_BINDINGS) {
+				return id;
+			}
+			if(kind == ALLOCATION_SCOPE_EVENT && id >= 0 && id < EVENT_TYPE_COUNT) {
+				return MAX_PROFILED_BINDINGS + id;
+			}
+			return -1;
+		}
+	}
+	
+	AllocationScope::AllocationScope(int kind, int id) : scope(getScope(kind, id)), previous(currentScope)
+	{
+		if(scope >= 0) {
+			scopeCounts[scope].calls.fetch_add(1, std::memory_order_relaxed);
+			currentScope = scope;
+		}
+	}
+	
+	AllocationScope::~AllocationScope()
+	{
+		if(scope >= 0) {
+			currentScope = previous;
+		}
+	}
+	
+	void recordAllocation(int kind, size_t bytes)
+	{
+		int scope = currentScope;
+		if(scope < 0 || kind < 0 || kind >= ALLOCATION_KIND_COUNT) {
+			return;
+		}
+		scopeCounts[scope].allocations[kind].fetch_add(1, std::memory_order_relaxed);
+		scopeCounts[scope].bytes[kind].fetch_add((long long)bytes, std::memory_order_relaxed);
+	}
+	
+	std::string getAllocationAudit()
+	{
+		std::string audit;
+		for(int scope = 0; scope < SCOPE_COUNT; scope++) {
+			const ScopeCounts& counts = scopeCounts[scope];
+			long long calls = counts.calls.load(std::memory_order_relaxed);
+			if(calls == 0) {
+				continue;
+			}
+			bool binding = scope < MAX_PROFILED_BINDINGS;
+			appendf(audit, "%s\t%s\t%lld\t%lld\t%lld\t%lld\t%lld\n",
+				binding ? "binding" : "event",
+				binding ? getBindingName(scope) : getEventName(scope - MAX_PROFILED_BINDINGS),
+				calls,
+				counts.allocations[ALLOCATION_NATIVE].load(std::memory_order_relaxed),
+				counts.bytes[ALLOCATION_NATIVE].load(std::memory_order_relaxed),
+				counts.allocations[ALLOCATION_GC].load(std::memory_order_relaxed),
+				counts.bytes[ALLOCATION_GC].load(std::memory_order_relaxed));
+		}
+		return audit;
+	}
+	
+	void resetAllocationAudit()
+	{
+		for(int scope = 0; scope < SCOPE_COUNT; scope++) {
+			scopeCounts[scope].calls.store(0, std::memory_order_relaxed);
+			for(int kind = 0; kind < ALLOCATION_KIND_COUNT; kind++) {
+				scopeCounts[scope].allocations[kind].store(0, std::memory_order_relaxed);
+				scopeCounts[scope].bytes[kind].store(0, std::memory_order_relaxed);
+			}
+		}
+	}
+}
+
+#ifdef SAMCODESCHARTBOOST_AUDIT_ALLOCATIONS
+
+// Replaces the global allocation functions for the whole process in audit builds, so C++ allocations on an audited path are
+// counted wherever they come from. Outside a scope this costs a thread local read.
+// Every form of new and delete is replaced, plain, array, nothrow, sized and aligned, so they all pair with the same malloc and free
+void* operator new(size_t size)
+{
+	samcodeschartboost::recordAllocation(samcodeschartboost::ALLOCATION_NATIVE, size);
+	void* memory = malloc(size > 0 ? size : 1);
+	if(memory == NULL) {
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	samcodeschartboost::recordAllocation(samcodeschartboost::ALLOCATION_NATIVE, size);
+	return malloc(size > 0 ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept
+{
+	return operator new(size, tag);
+}
+
+void operator delete(void* memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+	free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+	free(memory);
+}
+
+#ifdef __cpp_aligned_new
+
+// posix_memalign memory is released with free, like the rest
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	samcodeschartboost::recordAllocation(samcodeschartboost::ALLOCATION_NATIVE, size);
+	size_t align = (size_t)alignment < sizeof(void*) ? sizeof(void*) : (size_t)alignment;
+	void* memory = NULL;
+	if(posix_memalign(&memory, align, size > 0 ? size : 1) != 0) {
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	return operator new(size, alignment);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	samcodeschartboost::recordAllocation(samcodeschartboost::ALLOCATION_NATIVE, size);
+	size_t align = (size_t)alignment < sizeof(void*) ? sizeof(void*) : (size_t)alignment;
+	void* memory = NULL;
+	if(posix_memalign(&memory, align, size > 0 ? size : 1) != 0) {
+		return NULL;
+	}
+	return memory;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t& tag) noexcept
+{
+	return operator new(size, alignment, tag);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept
+{
+	free(memory);
+}
+
+void operator delete(void* memory, size_t, std::align_val_t) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void* memory, size_t, std::align_val_t) noexcept
+{
+	free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	free(memory);
+}
+
+#endif
+
+#endif
\ No newline at end of file
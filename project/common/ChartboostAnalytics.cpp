@@ -0,0 +1,98 @@
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ChartboostAnalytics.h"
+#include "SamcodesChartboost.h"
+
+namespace samcodeschartboost
+{
+	namespace
+	{
+		struct LevelInfo
+		{
+			std::string label;
+			int levelType;
+			int mainLevel;
+			int subLevel;
+			std::string description;
+		};
+		
+		std::mutex levelInfoMutex;
+		std::vector<LevelInfo> pendingLevelInfo;
+		std::atomic<bool> levelInfoFlushScheduled(false);
+		std::atomic<double> levelInfoFlushInterval(30.0);
+	}
+	
+	void trackLevelInfo(const char* label, int levelType, int mainLevel, int subLevel, const char* description)
+	{
+		{
+			std::lock_guard<std::mutex> lock(levelInfoMutex);
+			
+			// Only the latest value for a label and level type matters to the SDK, so replace any pending one
+			bool coalesced = false;
+			for(size_t i = 0; i < pendingLevelInfo.size(); i++) {
+				LevelInfo& info = pendingLevelInfo[i];
+				if(info.levelType == levelType && info.label == label) {
+					info.mainLevel = mainLevel;
+					info.subLevel = subLevel;
+					info.description = description;
+					coalesced = true;
+					break;
+				}
+			}
+			if(!coalesced) {
+				LevelInfo info;
+				info.label = label;
+				info.levelType = levelType;
+				info.mainLevel = mainLevel;
+				info.subLevel = subLevel;
+				info.description = description;
+				pendingLevelInfo.push_back(info);
+			}
+		}
+		
+		// The first event of a batch arms the flush timer, later ones just append
+		if(!levelInfoFlushScheduled.exchange(true)) {
+			scheduleLevelInfoFlush(levelInfoFlushInterval.load());
+		}
+	}
+	
+	void flushLevelInfo()
+	{
+		std::vector<LevelInfo> batch;
+		{
+			std::lock_guard<std::mutex> lock(levelInfoMutex);
+			batch.swap(pendingLevelInfo);
+			levelInfoFlushScheduled.store(false);
+		}
+		
+		for(size_t i = 0; i < batch.size(); i++) {
+			const LevelInfo& info = batch[i];
+			sendLevelInfo(info.label.c_str(), info.levelType, info.mainLevel, info.subLevel, info.description.c_str());
+		}
+	}
+	
+	void requestLevelInfoFlush()
+	{
+		{
+			std::lock_guard<std::mutex> lock(levelInfoMutex);
+			if(pendingLevelInfo.empty()) {
+				return;
+			}
+		}
+		scheduleLevelInfoFlush(0.0);
+	}
+	
+	void setLevelInfoFlushInterval(double seconds)
+	{
+		levelInfoFlushInterval.store(seconds);
+	}
+	
+	int getPendingLevelInfoCount()
+	{
+		std::lock_guard<std::mutex> lock(levelInfoMutex);
+		return (int)pendingLevelInfo.size();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include <atomic>
+#include <mutex>
+#include <string.h>
+
+#include "ChartboostBindingProfiler.h"
+#include "ChartboostClock.h"
+#include "ChartboostText.h"
+
+namespace samcodeschartboost
+{
+	namespace
+	{
+		const char* const bindingPrefix = "samcodeschartboost_";
+		
+		// Updated with relaxed atomics from whichever thread makes the call, so timing a binding never takes a lock
+		struct BindingProfile
+		{
+			const char* name;
+			std::atomic<long long> calls;
+			std::atomic<double> totalTime;
+			std::atomic<double> maxTime;
+			std::atomic<long long> stringBytes;
+		};
+		
+		BindingProfile bindings[MAX_PROFILED_BINDINGS];
+		std::atomic<int> bindingCount(0);
+		std::mutex registerMutex;
+		
+		void addTime(std::atomic<double>& total, double duration)
+		{
+			double current = total.load(std::memory_order_relaxed);
+			while(!total.compare_exchange_weak(current, current + duration, std::memory_order_relaxed)) {
+			}
+		}
+		
+		void raiseMax(std::atomic<double>& max, double duration)
+		{
+			double current = max.load(std::memory_order_relaxed);
+			while(duration > current && !max.compare_exchange_weak(current, duration, std::memory_order_relaxed)) {
+			}
+		}
+	}
+	
+	int registerBinding(const char* name)
+	{
+		std::lock_guard<std::mutex> lock(registerMutex);
+		int count = bindingCount.load();
+		if(count >= MAX_PROFILED_BINDINGS) {
+			return -1;
+		}
+		size_t prefixLength = strlen(bindingPrefix);
+		bindings[count].name = strncmp(name, bindingPrefix, prefixLength) == 0 ? name + prefixLength : name;
+		bindingCount.store(count + 1);
+		return count;
+	}
+	
+	const char* getBindingName(int binding)
+	{
+		if(binding < 0 || binding >= bindingCount.load()) {
+			return "";
+		}
+		return bindings[binding].name;
+	}
+	
+	ScopedBindingTimer::ScopedBindingTimer(int binding) : binding(binding), stringBytes(0), start(getMonotonicTime())
+	{
+	}
+	
+	ScopedBindingTimer::~ScopedBindingTimer()
+	{
+		if(binding < 0) {
+			return;
+		}
+		double duration = getMonotonicTime() - start;
+		BindingProfile& profile = bindings[binding];
+		profile.calls.fetch_add(1, std::memory_order_relaxed);
+		profile.stringBytes.fetch_add(stringBytes, std::memory_order_relaxed);
+		addTime(profile.totalTime, duration);
+		raiseMax(profile.maxTime, duration);
+	}
+	
+	std::string getBindingProfile()
+	{
+		std::string profile;
+		int count = bindingCount.load();
+		for(int i = 0; i < count; i++) {
+			const BindingProfile& binding = bindings[i];
+			long long calls = binding.calls.load(std::memory_order_relaxed);
+			if(calls == 0) {
+				continue;
+			}
+			appendf(profile, "%s\t%lld\t%.6f\t%.6f\t%lld\n", binding.name, calls, binding.totalTime.load(std::memory_order_relaxed), binding.maxTime.load(std::memory_order_relaxed), binding.stringBytes.load(std::memory_order_relaxed));
+		}
+		return profile;
+	}
+	
+	void resetBindingProfile()
+	{
+		int count = bindingCount.load();
+		for(int i = 0; i < count; i++) {
+			bindings[i].calls.store(0, std::memory_order_relaxed);
+			bindings[i].totalTime.store(0.0, std::memory_order_relaxed);
+			bindings[i].maxTime.store(0.0, std::memory_order_relaxed);
+			bindings[i].stringBytes.store(0, std::memory_order_relaxed);
+		}
+	}
+}
\ No newline at end of file
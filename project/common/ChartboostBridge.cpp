@@ -0,0 +1,54 @@
+#include "ChartboostPredictor.h"
+#include "ChartboostScheduler.h"
+#include "ChartboostSelector.h"
+#include "SamcodesChartboost.h"
+
+// The instances shared by the Haxe bindings and the platform backend. These are kept apart from the classes themselves
+// so the classes can be built without a platform backend, e.g. into the policy tuner
+namespace samcodeschartboost
+{
+	namespace
+	{
+		class PlatformSchedulerSink : public SchedulerSink
+		{
+		public:
+			virtual void issueCache(int adType, const char* location)
+			{
+				if(adType == AD_TYPE_INTERSTITIAL) {
+					cacheInterstitial(location);
+				} else if(adType == AD_TYPE_REWARDED_VIDEO) {
+					cacheRewardedVideo(location);
+				}
+			}
+			
+			virtual bool isCached(int adType, const char* location)
+			{
+				if(adType == AD_TYPE_INTERSTITIAL) {
+					return hasInterstitial(location);
+				} else if(adType == AD_TYPE_REWARDED_VIDEO) {
+					return hasRewardedVideo(location);
+				}
+				return false;
+			}
+		};
+	}
+	
+	Scheduler& getScheduler()
+	{
+		static PlatformSchedulerSink sink;
+		static Scheduler scheduler(&sink);
+		return scheduler;
+	}
+	
+	Predictor& getPredictor()
+	{
+		static Predictor predictor(getScheduler());
+		return predictor;
+	}
+	
+	Selector& getSelector()
+	{
+		static Selector selector;
+		return selector;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,491 @@
+#include <atomic>
+#include <stddef.h>
+#include <string.h>
+#include <string>
+
+#include "ChartboostAnalytics.h"
+#include "ChartboostCApi.h"
+#include "ChartboostClock.h"
+#include "ChartboostConsent.h"
+#include "ChartboostErrors.h"
+#include "ChartboostLocations.h"
+#include "ChartboostMemory.h"
+#include "ChartboostMetrics.h"
+#include "ChartboostPredictor.h"
+#include "ChartboostPurchases.h"
+#include "ChartboostScheduler.h"
+#include "ChartboostStartup.h"
+#include "ChartboostStates.h"
+#include "ChartboostWatchdog.h"
+#include "SamcodesChartboost.h"
+
+using namespace samcodeschartboost;
+
+static_assert(sizeof(scb_event) == sizeof(ChartboostEvent), "scb_event must match ChartboostEvent");
+static_assert(offsetof(scb_event, status) == offsetof(ChartboostEvent, status), "scb_event must match ChartboostEvent");
+static_assert(offsetof(scb_event, time) == offsetof(ChartboostEvent, time), "scb_event must match ChartboostEvent");
+static_assert((int)SCB_EVENT_DELIVERY_HANDLER == (int)EVENT_DELIVERY_LISTENER, "Event delivery modes must match");
+static_assert((int)SCB_CONSENT_CHANGE_RECACHE == (int)CONSENT_CHANGE_RECACHE, "Consent change policies must match");
+
+namespace
+{
+	// The C callbacks take a user data pointer, so the native callbacks go through these
+	std::atomic<scb_event_handler> eventHandler(NULL);
+	std::atomic<void*> eventHandlerData(NULL);
+	std::atomic<scb_event_callback> eventCallback(NULL);
+	std::atomic<void*> eventCallbackData(NULL);
+	std::atomic<scb_listener_callback> listenerCallback(NULL);
+	std::atomic<void*> listenerCallbackData(NULL);
+	
+	void forwardEvent(int type, int location, int error, int reward, bool status)
+	{
+		scb_event_callback callback = eventCallback.load();
+		if(callback != NULL) {
+			callback(type, location, error, reward, status ? 1 : 0, eventCallbackData.load());
+		}
+	}
+	
+	void forwardListenerEvent(int listener, int type, int location, int error, int reward, bool status)
+	{
+		scb_listener_callback callback = listenerCallback.load();
+		if(callback != NULL) {
+			callback(listener, type, location, error, reward, status ? 1 : 0, listenerCallbackData.load());
+		}
+	}
+	
+	int copyText(const char* text, char* buffer, int capacity)
+	{
+		if(text == NULL) {
+			text = "";
+		}
+		int length = (int)strlen(text);
+		if(buffer != NULL && capacity > 0) {
+			int copied = length < capacity - 1 ? length : capacity - 1;
+			memcpy(buffer, text, copied);
+			buffer[copied] = '\0';
+		}
+		return length;
+	}
+	
+	int copyText(const std::string& text, char* buffer, int capacity)
+	{
+		return copyText(text.c_str(), buffer, capacity);
+	}
+}
+
+// Events in handler delivery mode end up here, in place of the Haxe listener the CFFI bindings define it for
+extern "C" void sendChartboostEvent(const char* type, const char* location, const char* uri, int reward_coins, int error, bool status)
+{
+	scb_event_handler handler = eventHandler.load();
+	if(handler != NULL) {
+		handler(type, location, uri, reward_coins, error, status ? 1 : 0, eventHandlerData.load());
+	}
+}
+
+int scb_get_api_version(void)
+{
+	return SCB_API_VERSION;
+}
+
+void scb_init(const char* app_id, const char* app_signature)
+{
+	initChartboost(app_id, app_signature);
+}
+
+void scb_show_interstitial(const char* location)
+{
+	showInterstitial(location);
+}
+
+void scb_cache_interstitial(const char* location)
+{
+	cacheInterstitial(location);
+}
+
+int scb_has_interstitial(const char* location)
+{
+	return hasInterstitial(location) ? 1 : 0;
+}
+
+void scb_show_rewarded_video(const char* location)
+{
+	showRewardedVideo(location);
+}
+
+void scb_cache_rewarded_video(const char* location)
+{
+	cacheRewardedVideo(location);
+}
+
+int scb_has_rewarded_video(const char* location)
+{
+	return hasRewardedVideo(location) ? 1 : 0;
+}
+
+int scb_is_any_view_visible(void)
+{
+	return isAnyViewVisible() ? 1 : 0;
+}
+
+void scb_set_custom_id(const char* id)
+{
+	setCustomId(id);
+}
+
+int scb_get_custom_id(char* buffer, int capacity)
+{
+	return copyText(getCustomId(), buffer, capacity);
+}
+
+void scb_set_should_request_interstitials_in_first_session(int should_request)
+{
+	setShouldRequestInterstitialsInFirstSession(should_request != 0);
+}
+
+int scb_get_auto_cache_ads(void)
+{
+	return getAutoCacheAds() ? 1 : 0;
+}
+
+void scb_set_auto_cache_ads(int auto_cache)
+{
+	setAutoCacheAds(auto_cache != 0);
+}
+
+void scb_set_should_prefetch_video_content(int should_prefetch)
+{
+	setShouldPrefetchVideoContent(should_prefetch != 0);
+}
+
+int scb_get_sdk_version(char* buffer, int capacity)
+{
+	return copyText(getSDKVersion(), buffer, capacity);
+}
+
+void scb_set_muted(int mute)
+{
+	setMuted(mute != 0);
+}
+
+int scb_get_consent(void)
+{
+	return getConsent();
+}
+
+void scb_set_consent(int consent)
+{
+	changeConsent(consent);
+}
+
+void scb_set_consent_change_policy(int policy)
+{
+	setConsentChangePolicy(policy);
+}
+
+int scb_is_consent_stale(int ad_type, int location_index)
+{
+	return isConsentStale(ad_type, location_index) ? 1 : 0;
+}
+
+int scb_create_ad(int ad_type, const char* location)
+{
+	return createAd(ad_type, location);
+}
+
+void scb_release_ad(int handle)
+{
+	releaseAd(handle);
+}
+
+void scb_cache_ad(int handle)
+{
+	cacheAd(handle);
+}
+
+void scb_show_ad(int handle)
+{
+	showAd(handle);
+}
+
+int scb_is_ad_cached(int handle)
+{
+	return isAdCached(handle) ? 1 : 0;
+}
+
+int scb_acquire_banner(const char* location, int size)
+{
+	return acquireBanner(location, size);
+}
+
+void scb_release_banner(int handle)
+{
+	releaseBanner(handle);
+}
+
+void scb_show_banner(int handle)
+{
+	showBanner(handle);
+}
+
+void scb_hide_banner(int handle)
+{
+	hideBanner(handle);
+}
+
+void scb_set_banner_position(int handle, double x, double y)
+{
+	setBannerPosition(handle, x, y);
+}
+
+void scb_set_banner_refresh_interval(int handle, double seconds)
+{
+	setBannerRefreshInterval(handle, seconds);
+}
+
+int scb_is_banner_cached(int handle)
+{
+	return isBannerCached(handle) ? 1 : 0;
+}
+
+void scb_update_banners(double dt, int frame_budget_tight)
+{
+	updateBanners(dt, frame_budget_tight != 0);
+}
+
+void scb_track_level_info(const char* label, int level_type, int main_level, int sub_level, const char* description)
+{
+	trackLevelInfo(label, level_type, main_level, sub_level, description);
+}
+
+void scb_flush_level_info(void)
+{
+	flushLevelInfo();
+}
+
+void scb_track_in_app_purchase(const unsigned char* receipt, int receipt_length, const char* title, const char* description, const char* price, const char* currency, const char* product_id)
+{
+	queuePurchase(receipt, receipt_length, false, title, description, price, currency, product_id);
+}
+
+void scb_set_event_delivery_mode(int mode)
+{
+	setEventDeliveryMode(mode);
+}
+
+int scb_get_event_delivery_mode(void)
+{
+	return getEventDeliveryMode();
+}
+
+void scb_set_event_handler(scb_event_handler handler, void* user_data)
+{
+	eventHandlerData.store(user_data);
+	eventHandler.store(handler);
+}
+
+void scb_set_event_callback(scb_event_callback callback, void* user_data)
+{
+	if(callback == NULL) {
+		scb_clear_event_callback();
+		return;
+	}
+	eventCallbackData.store(user_data);
+	eventCallback.store(callback);
+	setEventCallback(forwardEvent);
+}
+
+void scb_clear_event_callback(void)
+{
+	clearEventCallback();
+	eventCallback.store(NULL);
+}
+
+void scb_set_event_coalescing(int coalesce)
+{
+	setEventCoalescing(coalesce != 0);
+}
+
+const char* scb_get_event_name(int type)
+{
+	return getEventName(type);
+}
+
+const scb_event* scb_get_event_ring(void)
+{
+	return reinterpret_cast<const scb_event*>(getEventRing());
+}
+
+int scb_get_event_ring_capacity(void)
+{
+	return getEventRingCapacity();
+}
+
+uint32_t scb_get_event_write_index(void)
+{
+	return getEventWriteIndex();
+}
+
+uint32_t scb_get_event_read_index(void)
+{
+	return getEventReadIndex();
+}
+
+void scb_commit_event_read_index(uint32_t index)
+{
+	commitEventReadIndex(index);
+}
+
+int scb_get_dropped_event_count(void)
+{
+	return getDroppedEventCount();
+}
+
+void scb_set_listener_callback(scb_listener_callback callback, void* user_data)
+{
+	listenerCallbackData.store(user_data);
+	listenerCallback.store(callback);
+	setListenerCallback(callback != NULL ? forwardListenerEvent : NULL);
+}
+
+int scb_add_listener(int mask, int priority)
+{
+	return addListener(mask, priority);
+}
+
+void scb_remove_listener(int listener)
+{
+	removeListener(listener);
+}
+
+void scb_set_listener_mask(int listener, int mask)
+{
+	setListenerMask(listener, mask);
+}
+
+int scb_get_location_index(const char* location)
+{
+	return internLocation(location);
+}
+
+const char* scb_get_location_name(int index)
+{
+	return getLocationName(index);
+}
+
+int scb_get_location_state(int ad_type, int location_index)
+{
+	return getLocationState(ad_type, location_index);
+}
+
+void scb_request_cache(int ad_type, const char* location, int urgent)
+{
+	getScheduler().request(ad_type, location, urgent != 0, getMonotonicTime());
+}
+
+void scb_begin_idle_window(void)
+{
+	getScheduler().beginIdleWindow(getMonotonicTime());
+}
+
+void scb_end_idle_window(void)
+{
+	getScheduler().endIdleWindow(getMonotonicTime());
+}
+
+void scb_update_scheduler(void)
+{
+	double now = getMonotonicTime();
+	getPredictor().update(now);
+	getScheduler().update(now);
+}
+
+void scb_set_scheduler_policy(const scb_scheduler_policy* policy)
+{
+	SchedulerPolicy schedulerPolicy;
+	schedulerPolicy.maxInFlight = policy->max_in_flight;
+	schedulerPolicy.maxRetries = policy->max_retries;
+	schedulerPolicy.retryBackoff = policy->retry_backoff;
+	schedulerPolicy.requestTimeout = policy->request_timeout;
+	schedulerPolicy.deferOutsideIdle = policy->defer_outside_idle != 0;
+	getScheduler().setPolicy(schedulerPolicy);
+}
+
+void scb_get_scheduler_policy(scb_scheduler_policy* policy)
+{
+	SchedulerPolicy schedulerPolicy = getScheduler().getPolicy();
+	policy->max_in_flight = schedulerPolicy.maxInFlight;
+	policy->max_retries = schedulerPolicy.maxRetries;
+	policy->retry_backoff = schedulerPolicy.retryBackoff;
+	policy->request_timeout = schedulerPolicy.requestTimeout;
+	policy->defer_outside_idle = schedulerPolicy.deferOutsideIdle ? 1 : 0;
+}
+
+int scb_get_scheduler_pending_count(void)
+{
+	return getScheduler().getPendingCount();
+}
+
+int scb_get_scheduler_in_flight_count(void)
+{
+	return getScheduler().getInFlightCount();
+}
+
+void scb_get_scheduler_stats(scb_scheduler_stats* stats)
+{
+	SchedulerStats schedulerStats = getScheduler().getStats();
+	stats->requested = schedulerStats.requested;
+	stats->issued = schedulerStats.issued;
+	stats->urgent_issued = schedulerStats.urgentIssued;
+	stats->issued_outside_idle = schedulerStats.issuedOutsideIdle;
+	stats->succeeded = schedulerStats.succeeded;
+	stats->failed = schedulerStats.failed;
+	stats->retries = schedulerStats.retries;
+	stats->timeouts = schedulerStats.timeouts;
+	stats->already_cached = schedulerStats.alreadyCached;
+	stats->total_queue_time = schedulerStats.totalQueueTime;
+	stats->total_cache_time = schedulerStats.totalCacheTime;
+}
+
+int scb_get_error_count(int code)
+{
+	return getErrorCount(code);
+}
+
+const char* scb_get_error_name(int code)
+{
+	return getErrorName(code);
+}
+
+void scb_get_stall_stats(scb_stall_stats* stats)
+{
+	StallStats stallStats = getStallStats();
+	stats->calls = stallStats.calls;
+	stats->stalls = stallStats.stalls;
+	stats->hangs = stallStats.hangs;
+	stats->max_duration = stallStats.maxDuration;
+}
+
+void scb_get_memory_stats(scb_memory_stats* stats)
+{
+	MemoryStats memoryStats = getMemoryStats();
+	stats->before_init = memoryStats.beforeInit;
+	stats->after_init = memoryStats.afterInit;
+	stats->last_sample = memoryStats.lastSample;
+	stats->peak_sample = memoryStats.peakSample;
+	stats->samples = memoryStats.samples;
+}
+
+int scb_get_open_metrics_text(char* buffer, int capacity)
+{
+	return copyText(getOpenMetricsText(&getScheduler()), buffer, capacity);
+}
+
+int scb_get_startup_report(char* buffer, int capacity)
+{
+	return copyText(getStartupReport(), buffer, capacity);
+}
+
+int scb_get_memory_report(char* buffer, int capacity)
+{
+	return copyText(getMemoryReport(), buffer, capacity);
+}
\ No newline at end of file
@@ -0,0 +1,11 @@
+#include <chrono>
+
+#include "ChartboostClock.h"
+
+namespace samcodeschartboost
+{
+	double getMonotonicTime()
+	{
+		return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,175 @@
+#include <atomic>
+#include <mutex>
+#include <stdio.h>
+#include <string>
+
+#include "ChartboostConsent.h"
+#include "ChartboostLocations.h"
+#include "ChartboostScheduler.h"
+#include "ChartboostStates.h"
+#include "SamcodesChartboost.h"
+
+namespace samcodeschartboost
+{
+	namespace
+	{
+		const char* consentFileName = "samcodeschartboost_consent.txt";
+		
+		std::mutex consentMutex; // Serializes loading and changes, reads of a known consent don't take it
+		std::atomic<int> consent(CONSENT_UNKNOWN);
+		std::atomic<bool> consentKnown(false); // Set once the consent has come from the persisted file, the SDK or a change
+		bool persistedConsentLoaded = false;
+		
+		std::atomic<int> changePolicy(CONSENT_CHANGE_INVALIDATE);
+		std::atomic<int> changeCount(0);
+		
+		// Bumped by every change that doesn't keep old placements, placements remember the generation they were requested under
+		std::atomic<int> consentGeneration(0);
+		std::atomic<int> requestGenerations[AD_TYPE_COUNT][MAX_LOCATIONS];
+		
+		bool isValidConsent(int value)
+		{
+			return value == CONSENT_UNKNOWN || value == CONSENT_NO_BEHAVIORAL || value == CONSENT_YES_BEHAVIORAL;
+		}
+		
+		bool isValidPlacement(int adType, int locationIndex)
+		{
+			return adType >= 0 && adType < AD_TYPE_COUNT && locationIndex >= 0 && locationIndex < MAX_LOCATIONS;
+		}
+		
+		// Must be called with the consent mutex held
+		void loadPersistedConsent()
+		{
+			if(persistedConsentLoaded) {
+				return;
+			}
+			persistedConsentLoaded = true;
+			
+			std::string path = getStoragePath(consentFileName);
+			FILE* file = fopen(path.c_str(), "rb");
+			if(file == NULL) {
+				return;
+			}
+			int value;
+			if(fscanf(file, "%d", &value) == 1 && isValidConsent(value)) {
+				consent.store(value);
+				consentKnown.store(true, std::memory_order_release);
+			}
+			fclose(file);
+		}
+		
+		// Written to a temporary file and renamed over the old one, so a crash mid write leaves the previous value
+		void persistConsent(int value)
+		{
+			std::string path = getStoragePath(consentFileName);
+			std::string temporaryPath = path + ".tmp";
+			FILE* file = fopen(temporaryPath.c_str(), "wb");
+			if(file == NULL) {
+				return;
+			}
+			bool written = fprintf(file, "%d\n", value) > 0;
+			written = fclose(file) == 0 && written;
+			if(!written || rename(temporaryPath.c_str(), path.c_str()) != 0) {
+				remove(temporaryPath.c_str());
+			}
+		}
+	}
+	
+	int getConsent()
+	{
+		if(consentKnown.load(std::memory_order_acquire)) {
+			return consent.load();
+		}
+		std::lock_guard<std::mutex> lock(consentMutex);
+		loadPersistedConsent();
+		if(!consentKnown.load()) {
+			consent.store(getPIDataUseConsent());
+			consentKnown.store(true, std::memory_order_release);
+		}
+		return consent.load();
+	}
+	
+	void changeConsent(int value)
+	{
+		if(!isValidConsent(value)) {
+			return;
+		}
+		
+		std::lock_guard<std::mutex> lock(consentMutex);
+		loadPersistedConsent();
+		if(consentKnown.load() && consent.load() == value) {
+			return;
+		}
+		consent.store(value);
+		consentKnown.store(true, std::memory_order_release);
+		changeCount++;
+		
+		setPIDataUseConsent(value);
+		
+		// Stale placements can't be requested again until their ad is shown, see onConsentPlacementDisplayed
+		if(changePolicy.load() != CONSENT_CHANGE_KEEP) {
+			consentGeneration++;
+		}
+		
+		persistConsent(value);
+	}
+	
+	void applyPersistedConsent()
+	{
+		std::lock_guard<std::mutex> lock(consentMutex);
+		loadPersistedConsent();
+		if(consentKnown.load()) {
+			setPIDataUseConsent(consent.load());
+		}
+	}
+	
+	void setConsentChangePolicy(int policy)
+	{
+		if(policy >= CONSENT_CHANGE_KEEP && policy <= CONSENT_CHANGE_RECACHE) {
+			changePolicy.store(policy);
+		}
+	}
+	
+	int getConsentChangePolicy()
+	{
+		return changePolicy.load();
+	}
+	
+	void noteConsentRequest(int adType, int locationIndex)
+	{
+		if(isValidPlacement(adType, locationIndex)) {
+			requestGenerations[adType][locationIndex].store(consentGeneration.load());
+		}
+	}
+	
+	void onConsentPlacementDisplayed(int adType, const char* location, double now)
+	{
+		if(changePolicy.load() != CONSENT_CHANGE_RECACHE) {
+			return;
+		}
+		int locationIndex = findLocation(location);
+		if(!isValidPlacement(adType, locationIndex)) {
+			return;
+		}
+		if(requestGenerations[adType][locationIndex].load() != consentGeneration.load()) {
+			getScheduler().request(adType, location, false, now);
+		}
+	}
+	
+	bool isConsentStale(int adType, int locationIndex)
+	{
+		if(!isValidPlacement(adType, locationIndex)) {
+			return false;
+		}
+		int state = getLocationState(adType, locationIndex);
+		if(state != LOCATION_REQUESTING && state != LOCATION_CACHED) {
+			return false;
+		}
+		return requestGenerations[adType][locationIndex].load() != consentGeneration.load();
+	}
+	
+	int getConsentChangeCount()
+	{
+		return changeCount.load();
+	}
+}
\ No newline at end of file
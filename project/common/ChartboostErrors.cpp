@@ -0,0 +1,124 @@
+#include <atomic>
+#include <string.h>
+
+#include "ChartboostErrors.h"
+
+namespace samcodeschartboost
+{
+	namespace
+	{
+		struct ErrorInfo
+		{
+			const char* name;
+			int iosImpression;
+			int iosClick;
+			int androidImpression;
+			int androidClick;
+			bool retryable;
+		};
+		
+		const ErrorInfo errorInfos[ERROR_CODE_COUNT] = {
+			#define CHARTBOOST_ERROR(name, id, iosImpression, iosClick, androidImpression, androidClick, retryable) { #name, iosImpression, iosClick, androidImpression, androidClick, retryable },
+			#include "ChartboostErrorTable.h"
+			#undef CHARTBOOST_ERROR
+		};
+		
+		// Platform codes are small, so classification is a single array lookup into these
+		const int maxPlatformCode = 64;
+		
+		struct ErrorLookup
+		{
+			signed char impression[maxPlatformCode];
+			signed char click[maxPlatformCode];
+			
+			ErrorLookup()
+			{
+				for(int i = 0; i < maxPlatformCode; i++) {
+					impression[i] = ERROR_UNKNOWN;
+					click[i] = ERROR_UNKNOWN;
+				}
+				for(int code = 0; code < ERROR_CODE_COUNT; code++) {
+					#if defined(ANDROID)
+					int impressionCode = errorInfos[code].androidImpression;
+					int clickCode = errorInfos[code].androidClick;
+					#else
+					int impressionCode = errorInfos[code].iosImpression;
+					int clickCode = errorInfos[code].iosClick;
+					#endif
+					if(impressionCode >= 0 && impressionCode < maxPlatformCode) {
+						impression[impressionCode] = (signed char)code;
+					}
+					if(clickCode >= 0 && clickCode < maxPlatformCode) {
+						click[clickCode] = (signed char)code;
+					}
+				}
+			}
+		};
+		
+		const ErrorLookup errorLookup;
+		
+		std::atomic<int> errorCounts[ERROR_CODE_COUNT + 1];
+	}
+	
+	int classifyError(int domain, int platformCode)
+	{
+		if(platformCode < 0 || platformCode >= maxPlatformCode) {
+			return ERROR_UNKNOWN;
+		}
+		if(domain == ERROR_DOMAIN_CLICK) {
+			return errorLookup.click[platformCode];
+		}
+		return errorLookup.impression[platformCode];
+	}
+	
+	bool isErrorRetryable(int code)
+	{
+		if(code < 0 || code >= ERROR_CODE_COUNT) {
+			return false;
+		}
+		return errorInfos[code].retryable;
+	}
+	
+	const char* getErrorName(int code)
+	{
+		if(code < 0 || code >= ERROR_CODE_COUNT) {
+			return "UNKNOWN";
+		}
+		return errorInfos[code].name;
+	}
+	
+	int findErrorCode(const char* name)
+	{
+		for(int code = 0; code < ERROR_CODE_COUNT; code++) {
+			if(strcmp(errorInfos[code].name, name) == 0) {
+				return code;
+			}
+		}
+		return ERROR_UNKNOWN;
+	}
+	
+	// Unknown errors are counted in the extra slot at the end
+	int recordError(int domain, int platformCode)
+	{
+		int code = classifyError(domain, platformCode);
+		int index = code == ERROR_UNKNOWN ? ERROR_CODE_COUNT : code;
+		errorCounts[index].fetch_add(1, std::memory_order_relaxed);
+		return code;
+	}
+	
+	int getErrorCount(int code)
+	{
+		int index = code == ERROR_UNKNOWN ? ERROR_CODE_COUNT : code;
+		if(index < 0 || index > ERROR_CODE_COUNT) {
+			return 0;
+		}
+		return errorCounts[index].load(std::memory_order_relaxed);
+	}
+	
+	void resetErrorCounts()
+	{
+		for(int i = 0; i <= ERROR_CODE_COUNT; i++) {
+			errorCounts[i].store(0, std::memory_order_relaxed);
+		}
+	}
+}
\ No newline at end of file
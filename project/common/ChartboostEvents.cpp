@@ -0,0 +1,205 @@
+#include <atomic>
+#include <mutex>
+
+#include "ChartboostClock.h"
+#include "ChartboostLocations.h"
+#include "ChartboostProbes.h"
+#include "SamcodesChartboost.h"
+
+extern "C" void sendChartboostEvent(const char* type, const char* location, const char* uri, int reward_coins, int error, bool status);
+
+namespace samcodeschartboost
+{
+	static_assert(sizeof(ChartboostEvent) == 32, "ChartboostEvent layout is read from Haxe and must not change");
+	
+	namespace
+	{
+		const int EVENT_RING_CAPACITY = 256; // Must be a power of two
+		
+		const char* eventNames[] = {
+			#define CHARTBOOST_EVENT(name, id, callbackName) #callbackName,
+			#include "ChartboostEventTable.h"
+			#undef CHARTBOOST_EVENT
+		};
+		
+		ChartboostEvent eventRing[EVENT_RING_CAPACITY];
+		std::atomic<uint32_t> eventWriteIndex(0);
+		std::atomic<uint32_t> eventReadIndex(0);
+		std::atomic<int> droppedEvents(0);
+		std::atomic<int> deliveryMode(EVENT_DELIVERY_LISTENER);
+		std::atomic<EventCallback> eventCallback(NULL);
+		std::atomic<bool> eventCoalescing(false);
+		std::atomic<bool> eventWakeupPending(false);
+		std::mutex producerMutex;
+		
+		// Fires event_deliver for the slots from read up to write, however they end up being consumed
+		void probeDelivered(uint32_t read, uint32_t write)
+		{
+			if(!SCB_PROBE_ENABLED(event_deliver)) {
+				return;
+			}
+			double now = getMonotonicTime();
+			for(; read != write; read++) {
+				const ChartboostEvent& event = eventRing[read & (EVENT_RING_CAPACITY - 1)];
+				SCB_PROBE3(event_deliver, event.type, event.location, SCB_PROBE_NANOSECONDS(now - event.time));
+			}
+		}
+	}
+	
+	void setEventDeliveryMode(int mode)
+	{
+		deliveryMode.store(mode);
+	}
+	
+	int getEventDeliveryMode()
+	{
+		return deliveryMode.load();
+	}
+	
+	void setEventCallback(EventCallback callback)
+	{
+		eventCallback.store(callback);
+		deliveryMode.store(callback != NULL ? EVENT_DELIVERY_CALLBACK : EVENT_DELIVERY_LISTENER);
+	}
+	
+	void clearEventCallback()
+	{
+		setEventCallback(NULL);
+	}
+	
+	EventCallback getEventCallback()
+	{
+		return eventCallback.load();
+	}
+	
+	const char* getEventName(int type)
+	{
+		if(type < 0 || type >= EVENT_TYPE_COUNT) {
+			return "";
+		}
+		return eventNames[type];
+	}
+	
+	void pushEvent(int type, int location, int error, int reward, bool status, double time)
+	{
+		std::lock_guard<std::mutex> lock(producerMutex);
+		uint32_t write = eventWriteIndex.load(std::memory_order_relaxed);
+		if(write - eventReadIndex.load(std::memory_order_acquire) >= (uint32_t)EVENT_RING_CAPACITY) {
+			droppedEvents++;
+			return;
+		}
+		
+		ChartboostEvent& event = eventRing[write & (EVENT_RING_CAPACITY - 1)];
+		event.type = type;
+		event.location = location;
+		event.error = error;
+		event.reward = reward;
+		event.status = status ? 1 : 0;
+		event.reserved = 0;
+		event.time = time;
+		eventWriteIndex.store(write + 1, std::memory_order_release);
+		
+		if(SCB_PROBE_ENABLED(event_enqueue)) {
+			SCB_PROBE2(event_enqueue, type, location);
+		}
+	}
+	
+	const ChartboostEvent* getEventRing()
+	{
+		return eventRing;
+	}
+	
+	int getEventRingCapacity()
+	{
+		return EVENT_RING_CAPACITY;
+	}
+	
+	uint32_t getEventWriteIndex()
+	{
+		return eventWriteIndex.load(std::memory_order_acquire);
+	}
+	
+	uint32_t getEventReadIndex()
+	{
+		return eventReadIndex.load(std::memory_order_relaxed);
+	}
+	
+	void commitEventReadIndex(uint32_t index)
+	{
+		probeDelivered(eventReadIndex.load(std::memory_order_relaxed), index);
+		eventReadIndex.store(index, std::memory_order_release);
+	}
+	
+	int getDroppedEventCount()
+	{
+		return droppedEvents.load();
+	}
+	
+	void setEventCoalescing(bool coalesce)
+	{
+		eventCoalescing.store(coalesce);
+	}
+	
+	bool getEventCoalescing()
+	{
+		return eventCoalescing.load();
+	}
+	
+	bool markEventWakeupPending()
+	{
+		return !eventWakeupPending.exchange(true);
+	}
+	
+	int deliverPendingEvents()
+	{
+		// Cleared before reading, so events pushed while this batch is delivered schedule another wakeup rather than being missed
+		eventWakeupPending.store(false);
+		
+		// After a switch to ring delivery the game reads the ring itself, so anything still queued is left for it
+		int mode = deliveryMode.load();
+		if(mode == EVENT_DELIVERY_RING) {
+			return 0;
+		}
+		
+		uint32_t read = eventReadIndex.load(std::memory_order_relaxed);
+		uint32_t write = eventWriteIndex.load(std::memory_order_acquire);
+		int count = (int)(write - read);
+		
+		// The batch may wrap around the end of the ring, in which case it goes out as two runs of slots
+		uint32_t delivered = 0;
+		while(delivered < (uint32_t)count) {
+			int start = (int)((read + delivered) & (EVENT_RING_CAPACITY - 1));
+			int run = EVENT_RING_CAPACITY - start;
+			if(run > count - (int)delivered) {
+				run = count - (int)delivered;
+			}
+			
+			probeDelivered(read + delivered, read + delivered + run);
+			
+			if(mode == EVENT_DELIVERY_LISTENERS) {
+				deliverToListeners(eventRing + start, run);
+			} else if(mode == EVENT_DELIVERY_CALLBACK) {
+				EventCallback callback = eventCallback.load();
+				if(callback == NULL) {
+					droppedEvents += run;
+				}
+				for(int i = start; i < start + run && callback != NULL; i++) {
+					const ChartboostEvent& event = eventRing[i];
+					callback(event.type, event.location, event.error, event.reward, event.status != 0);
+				}
+			} else if(mode == EVENT_DELIVERY_LISTENER) {
+				// Event and location names live as long as the process, so nothing is copied for the Haxe listener
+				for(int i = start; i < start + run; i++) {
+					const ChartboostEvent& event = eventRing[i];
+					sendChartboostEvent(getEventName(event.type), getLocationName(event.location), "", event.reward, event.error, event.status != 0);
+				}
+			} else {
+				droppedEvents += run;
+			}
+			delivered += run;
+		}
+		
+		eventReadIndex.store(write, std::memory_order_release);
+		return count;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include <mutex>
+
+#include "ChartboostClock.h"
+#include "ChartboostFlightRecorder.h"
+#include "ChartboostLocations.h"
+#include "ChartboostText.h"
+
+namespace samcodeschartboost
+{
+	namespace
+	{
+		const int FLIGHT_RECORDER_CAPACITY = 128;
+		
+		const char* kindNames[] = { "stall", "hang" };
+		
+		struct FlightRecord
+		{
+			double time;
+			int kind;
+			const char* name;
+			int location;
+			double value;
+		};
+		
+		FlightRecord records[FLIGHT_RECORDER_CAPACITY];
+		unsigned int recordCount = 0;
+		std::mutex recorderMutex;
+	}
+	
+	void recordFlightEvent(int kind, const char* name, int location, double value)
+	{
+		double now = getMonotonicTime();
+		std::lock_guard<std::mutex> lock(recorderMutex);
+		FlightRecord& record = records[recordCount % FLIGHT_RECORDER_CAPACITY];
+		record.time = now;
+		record.kind = kind;
+		record.name = name;
+		record.location = location;
+		record.value = value;
+		recordCount++;
+	}
+	
+	std::string getFlightRecorderDump()
+	{
+		std::lock_guard<std::mutex> lock(recorderMutex);
+		std::string dump;
+		unsigned int first = recordCount > FLIGHT_RECORDER_CAPACITY ? recordCount - FLIGHT_RECORDER_CAPACITY : 0;
+		for(unsigned int i = first; i < recordCount; i++) {
+			const FlightRecord& record = records[i % FLIGHT_RECORDER_CAPACITY];
+			int kind = record.kind >= 0 && record.kind < (int)(sizeof(kindNames) / sizeof(kindNames[0])) ? record.kind : 0;
+			appendf(dump, "%.6f %s %s %s %.6f\n", record.time, kindNames[kind], record.name, record.location >= 0 ? getLocationName(record.location) : "-", record.value);
+		}
+		return dump;
+	}
+}
\ No newline at end of file
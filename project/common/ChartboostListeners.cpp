@@ -0,0 +1,117 @@
+#include <atomic>
+#include <mutex>
+
+#include "SamcodesChartboost.h"
+
+namespace samcodeschartboost
+{
+	static_assert(EVENT_TYPE_COUNT <= 32, "Listener masks have one bit per event type");
+	
+	namespace
+	{
+		const int MAX_LISTENERS = 16;
+		
+		struct Listener
+		{
+			int id;
+			int mask;
+			int priority;
+		};
+		
+		// Kept sorted by priority, highest first
+		Listener listeners[MAX_LISTENERS];
+		int listenerCount = 0;
+		int nextListenerId = 1;
+		std::atomic<ListenerCallback> listenerCallback(NULL);
+		int previousDeliveryMode = EVENT_DELIVERY_LISTENER; // The mode to go back to once the last listener is removed
+		std::mutex listenersMutex;
+	}
+	
+	void setListenerCallback(ListenerCallback callback)
+	{
+		listenerCallback.store(callback);
+	}
+	
+	int addListener(int mask, int priority)
+	{
+		std::lock_guard<std::mutex> lock(listenersMutex);
+		if(listenerCount >= MAX_LISTENERS) {
+			return -1;
+		}
+		
+		int index = listenerCount;
+		while(index > 0 && listeners[index - 1].priority < priority) {
+			listeners[index] = listeners[index - 1];
+			index--;
+		}
+		listeners[index].id = nextListenerId++;
+		listeners[index].mask = mask;
+		listeners[index].priority = priority;
+		listenerCount++;
+		
+		int mode = getEventDeliveryMode();
+		if(mode != EVENT_DELIVERY_LISTENERS) {
+			previousDeliveryMode = mode;
+			setEventDeliveryMode(EVENT_DELIVERY_LISTENERS);
+		}
+		return listeners[index].id;
+	}
+	
+	void removeListener(int listener)
+	{
+		std::lock_guard<std::mutex> lock(listenersMutex);
+		for(int i = 0; i < listenerCount; i++) {
+			if(listeners[i].id != listener) {
+				continue;
+			}
+			for(int j = i + 1; j < listenerCount; j++) {
+				listeners[j - 1] = listeners[j];
+			}
+			listenerCount--;
+			if(listenerCount == 0 && getEventDeliveryMode() == EVENT_DELIVERY_LISTENERS) {
+				setEventDeliveryMode(previousDeliveryMode);
+			}
+			return;
+		}
+	}
+	
+	void setListenerMask(int listener, int mask)
+	{
+		std::lock_guard<std::mutex> lock(listenersMutex);
+		for(int i = 0; i < listenerCount; i++) {
+			if(listeners[i].id == listener) {
+				listeners[i].mask = mask;
+				return;
+			}
+		}
+	}
+	
+	void deliverToListeners(const ChartboostEvent* events, int count)
+	{
+		ListenerCallback callback = listenerCallback.load();
+		if(callback == NULL) {
+			return;
+		}
+		
+		// Listeners may add or remove listeners from inside the callback, so the batch goes to the listeners registered when it started
+		Listener snapshot[MAX_LISTENERS];
+		int snapshotCount;
+		{
+			std::lock_guard<std::mutex> lock(listenersMutex);
+			snapshotCount = listenerCount;
+			for(int i = 0; i < listenerCount; i++) {
+				snapshot[i] = listeners[i];
+			}
+		}
+		
+		for(int e = 0; e < count; e++) {
+			const ChartboostEvent& event = events[e];
+			int bit = 1 << event.type;
+			for(int i = 0; i < snapshotCount; i++) {
+				if((snapshot[i].mask & bit) != 0) {
+					callback(snapshot[i].id, event.type, event.location, event.error, event.reward, event.status != 0);
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
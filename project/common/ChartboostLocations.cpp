@@ -0,0 +1,55 @@
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "ChartboostLocations.h"
+
+namespace samcodeschartboost
+{
+	namespace
+	{
+		std::mutex locationsMutex;
+		std::unordered_map<std::string, int> locationIndices;
+		// Names are only ever appended, and published through locationCount, so they can be read without the mutex
+		std::string locationNames[MAX_LOCATIONS];
+		std::atomic<int> locationCount(0);
+	}
+	
+	int internLocation(const char* location)
+	{
+		std::lock_guard<std::mutex> lock(locationsMutex);
+		std::unordered_map<std::string, int>::iterator it = locationIndices.find(location);
+		if(it != locationIndices.end()) {
+			return it->second;
+		}
+		int index = locationCount.load();
+		if(index >= MAX_LOCATIONS) {
+			return -1;
+		}
+		locationNames[index] = location;
+		locationIndices[location] = index;
+		locationCount.store(index + 1);
+		return index;
+	}
+	
+	int findLocation(const char* location)
+	{
+		std::lock_guard<std::mutex> lock(locationsMutex);
+		std::unordered_map<std::string, int>::iterator it = locationIndices.find(location);
+		return it == locationIndices.end() ? -1 : it->second;
+	}
+	
+	const char* getLocationName(int index)
+	{
+		if(index < 0 || index >= locationCount.load()) {
+			return "";
+		}
+		return locationNames[index].c_str();
+	}
+	
+	int getLocationCount()
+	{
+		return locationCount.load();
+	}
+}
\ No newline at end of file
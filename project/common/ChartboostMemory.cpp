@@ -0,0 +1,204 @@
+#include <mutex>
+
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#endif
+
+#include "ChartboostLocations.h"
+#include "ChartboostMemory.h"
+#include "ChartboostText.h"
+#include "SamcodesChartboost.h"
+
+namespace samcodeschartboost
+{
+	namespace
+	{
+		const char* adTypeNames[AD_TYPE_COUNT] = { "interstitial", "rewarded_video" };
+		
+		std::mutex memoryMutex;
+		MemoryStats stats = { -1, -1, -1, -1, 0 };
+		PlacementMemory placements[AD_TYPE_COUNT][MAX_LOCATIONS];
+		bool sampled[AD_TYPE_COUNT][MAX_LOCATIONS];
+		
+		// Resident memory when a placement's pending cache request or show started
+		struct StartSample
+		{
+			bool pending;
+			long long resident;
+		};
+		
+		StartSample cacheStarts[AD_TYPE_COUNT][MAX_LOCATIONS];
+		StartSample showStarts[AD_TYPE_COUNT][MAX_LOCATIONS];
+		
+		// Charges the change since a placement's start sample and clears the start, returning false if there was none
+		bool takeDelta(StartSample& start, long long resident, long long& delta)
+		{
+			if(!start.pending) {
+				return false;
+			}
+			delta = resident - start.resident;
+			start.pending = false;
+			return true;
+		}
+		
+		bool isValidPlacement(int adType, int locationIndex)
+		{
+			return adType >= 0 && adType < AD_TYPE_COUNT && locationIndex >= 0 && locationIndex < MAX_LOCATIONS;
+		}
+	}
+	
+	long long getResidentMemory()
+	{
+#if defined(__APPLE__)
+		mach_task_basic_info_data_t info;
+		mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+		if(task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+			return -1;
+		}
+		return (long long)info.resident_size;
+#elif defined(__linux__)
+		FILE* file = fopen("/proc/self/statm", "r");
+		if(file == NULL) {
+			return -1;
+		}
+		long long pages = -1;
+		long long residentPages = -1;
+		int fields = fscanf(file, "%lld %lld", &pages, &residentPages);
+		fclose(file);
+		if(fields != 2) {
+			return -1;
+		}
+		return residentPages * (long long)sysconf(_SC_PAGESIZE);
+#else
+		return -1;
+#endif
+	}
+	
+	void sampleMemory(int point, int adType, const char* location)
+	{
+		if(point < 0 || point >= MEMORY_SAMPLE_POINT_COUNT) {
+			return;
+		}
+		int index = -1;
+		if(point != MEMORY_BEFORE_INIT && point != MEMORY_AFTER_INIT) {
+			index = internLocation(location);
+			if(!isValidPlacement(adType, index)) {
+				return;
+			}
+		}
+		
+		long long resident = getResidentMemory();
+		if(resident < 0) {
+			return;
+		}
+		
+		std::lock_guard<std::mutex> lock(memoryMutex);
+		stats.lastSample = resident;
+		if(resident > stats.peakSample) {
+			stats.peakSample = resident;
+		}
+		stats.samples++;
+		
+		long long delta = 0;
+		switch(point) {
+			case MEMORY_BEFORE_INIT:
+				stats.beforeInit = resident;
+				break;
+			case MEMORY_AFTER_INIT:
+				if(stats.afterInit < 0) {
+					stats.afterInit = resident;
+				}
+				break;
+			case MEMORY_CACHE_START:
+				// A repeated request replaces the start, so one the SDK never answered can't leave a stale start behind
+				cacheStarts[adType][index].pending = true;
+				cacheStarts[adType][index].resident = resident;
+				break;
+			case MEMORY_SHOW_START:
+				showStarts[adType][index].pending = true;
+				showStarts[adType][index].resident = resident;
+				break;
+			case MEMORY_DID_CACHE:
+				if(takeDelta(cacheStarts[adType][index], resident, delta)) {
+					sampled[adType][index] = true;
+					placements[adType][index].caches++;
+					placements[adType][index].cacheDelta += delta;
+				}
+				break;
+			case MEMORY_DID_CLOSE:
+				if(takeDelta(showStarts[adType][index], resident, delta)) {
+					sampled[adType][index] = true;
+					placements[adType][index].closes++;
+					placements[adType][index].closeDelta += delta;
+				}
+				break;
+		}
+	}
+	
+	void cancelMemorySample(int point, int adType, const char* location)
+	{
+		int index = internLocation(location);
+		if(!isValidPlacement(adType, index)) {
+			return;
+		}
+		std::lock_guard<std::mutex> lock(memoryMutex);
+		if(point == MEMORY_CACHE_START) {
+			cacheStarts[adType][index].pending = false;
+		} else if(point == MEMORY_SHOW_START) {
+			showStarts[adType][index].pending = false;
+		}
+	}
+	
+	MemoryStats getMemoryStats()
+	{
+		std::lock_guard<std::mutex> lock(memoryMutex);
+		return stats;
+	}
+	
+	PlacementMemory getPlacementMemory(int adType, int locationIndex)
+	{
+		PlacementMemory memory = {};
+		if(!isValidPlacement(adType, locationIndex)) {
+			return memory;
+		}
+		std::lock_guard<std::mutex> lock(memoryMutex);
+		return placements[adType][locationIndex];
+	}
+	
+	std::string getMemoryReport()
+	{
+		std::lock_guard<std::mutex> lock(memoryMutex);
+		std::string report;
+		appendf(report, "init\t%lld\t%lld\nresident\t%lld\t%lld\n", stats.beforeInit, stats.afterInit, stats.lastSample, stats.peakSample);
+		int locationCount = getLocationCount();
+		for(int type = 0; type < AD_TYPE_COUNT; type++) {
+			for(int index = 0; index < locationCount && index < MAX_LOCATIONS; index++) {
+				if(!sampled[type][index]) {
+					continue;
+				}
+				const PlacementMemory& memory = placements[type][index];
+				appendf(report, "%s\t%s\t%d\t%lld\t%d\t%lld\n", adTypeNames[type], getLocationName(index), memory.caches, memory.cacheDelta, memory.closes, memory.closeDelta);
+			}
+		}
+		return report;
+	}
+	
+	void resetMemoryStats()
+	{
+		std::lock_guard<std::mutex> lock(memoryMutex);
+		stats.lastSample = -1;
+		stats.peakSample = -1;
+		stats.samples = 0;
+		for(int type = 0; type < AD_TYPE_COUNT; type++) {
+			for(int index = 0; index < MAX_LOCATIONS; index++) {
+				PlacementMemory memory = {};
+				placements[type][index] = memory;
+				sampled[type][index] = false;
+				cacheStarts[type][index].pending = false;
+				showStarts[type][index].pending = false;
+			}
+		}
+	}
+}
\ No newline at end of file
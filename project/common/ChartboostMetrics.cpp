@@ -0,0 +1,265 @@
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdio.h>
+#include <thread>
+
+#include "ChartboostErrors.h"
+#include "ChartboostLocations.h"
+#include "ChartboostMemory.h"
+#include "ChartboostMetrics.h"
+#include "ChartboostScheduler.h"
+#include "ChartboostStates.h"
+#include "ChartboostText.h"
+#include "ChartboostWatchdog.h"
+#include "SamcodesChartboost.h"
+
+namespace samcodeschartboost
+{
+	namespace
+	{
+		const char* adTypeNames[AD_TYPE_COUNT] = { "interstitial", "rewarded_video" };
+		const char* stateNames[LOCATION_STATE_COUNT] = { "idle", "requesting", "cached", "showing", "displayed", "closed", "failed" };
+		
+		std::mutex exportMutex;
+		std::condition_variable exportWake;
+		std::string exportPath;
+		double exportInterval = 10.0;
+		const Scheduler* exportScheduler = NULL;
+		int exportGeneration = 0; // Bumped on every start and stop, so a thread from an earlier export stops even if another was started since
+		bool exportRunning = false;
+		
+		// Location names come from the game, so they're escaped for use as label values
+		std::string escapeLabel(const char* value)
+		{
+			std::string escaped;
+			for(const char* c = value; *c != '\0'; c++) {
+				if(*c == '\\' || *c == '"') {
+					escaped += '\\';
+					escaped += *c;
+				} else if(*c == '\n') {
+					escaped += "\\n";
+				} else {
+					escaped += *c;
+				}
+			}
+			return escaped;
+		}
+		
+		// Upper bound of a dwell bucket in seconds, bucket n holds dwells under 2^n ms
+		double getDwellBucketBound(int bucket)
+		{
+			return (double)(1 << bucket) / 1000.0;
+		}
+		
+		void appendLocationMetrics(std::string& out)
+		{
+			int locationCount = getLocationCount();
+			
+			out += "# TYPE chartboost_location_state gauge\n";
+			out += "# HELP chartboost_location_state Current lifecycle state of each location, 0 idle, 1 requesting, 2 cached, 3 showing, 4 displayed, 5 closed, 6 failed.\n";
+			for(int type = 0; type < AD_TYPE_COUNT; type++) {
+				for(int index = 0; index < locationCount; index++) {
+					std::string location = escapeLabel(getLocationName(index));
+					appendf(out, "chartboost_location_state{ad_type=\"%s\",location=\"%s\"} %d\n", adTypeNames[type], location.c_str(), getLocationState(type, index));
+				}
+			}
+			
+			out += "# TYPE chartboost_location_dwell_seconds counter\n";
+			out += "# HELP chartboost_location_dwell_seconds Time each location has spent in each lifecycle state.\n";
+			for(int type = 0; type < AD_TYPE_COUNT; type++) {
+				for(int index = 0; index < locationCount; index++) {
+					std::string location = escapeLabel(getLocationName(index));
+					for(int state = 0; state < LOCATION_STATE_COUNT; state++) {
+						double dwell = getLocationDwellTime(type, index, state);
+						if(dwell > 0.0) {
+							appendf(out, "chartboost_location_dwell_seconds_total{ad_type=\"%s\",location=\"%s\",state=\"%s\"} %.6f\n", adTypeNames[type], location.c_str(), stateNames[state], dwell);
+						}
+					}
+				}
+			}
+			
+			out += "# TYPE chartboost_state_dwell_seconds histogram\n";
+			out += "# HELP chartboost_state_dwell_seconds Time spent in each lifecycle state per stay, across locations. Requesting is the cache latency.\n";
+			for(int type = 0; type < AD_TYPE_COUNT; type++) {
+				for(int state = 0; state < LOCATION_STATE_COUNT; state++) {
+					double sum = 0.0;
+					for(int index = 0; index < locationCount; index++) {
+						sum += getLocationDwellTime(type, index, state);
+					}
+					long long cumulative = 0;
+					for(int bucket = 0; bucket < DWELL_BUCKET_COUNT - 1; bucket++) {
+						cumulative += getDwellHistogramCount(type, state, bucket);
+						appendf(out, "chartboost_state_dwell_seconds_bucket{ad_type=\"%s\",state=\"%s\",le=\"%g\"} %lld\n", adTypeNames[type], stateNames[state], getDwellBucketBound(bucket), cumulative);
+					}
+					cumulative += getDwellHistogramCount(type, state, DWELL_BUCKET_COUNT - 1);
+					appendf(out, "chartboost_state_dwell_seconds_bucket{ad_type=\"%s\",state=\"%s\",le=\"+Inf\"} %lld\n", adTypeNames[type], stateNames[state], cumulative);
+					appendf(out, "chartboost_state_dwell_seconds_count{ad_type=\"%s\",state=\"%s\"} %lld\n", adTypeNames[type], stateNames[state], cumulative);
+					appendf(out, "chartboost_state_dwell_seconds_sum{ad_type=\"%s\",state=\"%s\"} %.6f\n", adTypeNames[type], stateNames[state], sum);
+				}
+			}
+		}
+		
+		void appendMemoryMetrics(std::string& out)
+		{
+			MemoryStats memory = getMemoryStats();
+			long long samples[] = { getResidentMemory(), memory.beforeInit, memory.afterInit, memory.lastSample, memory.peakSample };
+			const char* sampleNames[] = { "current", "before_init", "after_init", "last_sample", "peak_sample" };
+			
+			out += "# TYPE chartboost_resident_memory_bytes gauge\n";
+			out += "# HELP chartboost_resident_memory_bytes Resident memory of the process now and at the lifecycle points it was sampled.\n";
+			for(int i = 0; i < 5; i++) {
+				if(samples[i] >= 0) {
+					appendf(out, "chartboost_resident_memory_bytes{sample=\"%s\"} %lld\n", sampleNames[i], samples[i]);
+				}
+			}
+			
+			int locationCount = getLocationCount();
+			out += "# TYPE chartboost_placement_memory_delta_bytes gauge\n";
+			out += "# HELP chartboost_placement_memory_delta_bytes Change in resident memory from each cache request to its cache and from each show to its close, summed per placement.\n";
+			for(int type = 0; type < AD_TYPE_COUNT; type++) {
+				for(int index = 0; index < locationCount; index++) {
+					PlacementMemory placement = getPlacementMemory(type, index);
+					std::string location = escapeLabel(getLocationName(index));
+					if(placement.caches > 0) {
+						appendf(out, "chartboost_placement_memory_delta_bytes{ad_type=\"%s\",location=\"%s\",event=\"cache\"} %lld\n", adTypeNames[type], location.c_str(), placement.cacheDelta);
+					}
+					if(placement.closes > 0) {
+						appendf(out, "chartboost_placement_memory_delta_bytes{ad_type=\"%s\",location=\"%s\",event=\"close\"} %lld\n", adTypeNames[type], location.c_str(), placement.closeDelta);
+					}
+				}
+			}
+			
+			out += "# TYPE chartboost_placement_memory_samples counter\n";
+			for(int type = 0; type < AD_TYPE_COUNT; type++) {
+				for(int index = 0; index < locationCount; index++) {
+					PlacementMemory placement = getPlacementMemory(type, index);
+					std::string location = escapeLabel(getLocationName(index));
+					if(placement.caches > 0) {
+						appendf(out, "chartboost_placement_memory_samples_total{ad_type=\"%s\",location=\"%s\",event=\"cache\"} %d\n", adTypeNames[type], location.c_str(), placement.caches);
+					}
+					if(placement.closes > 0) {
+						appendf(out, "chartboost_placement_memory_samples_total{ad_type=\"%s\",location=\"%s\",event=\"close\"} %d\n", adTypeNames[type], location.c_str(), placement.closes);
+					}
+				}
+			}
+		}
+		
+		void appendSchedulerMetrics(std::string& out, const Scheduler& scheduler)
+		{
+			SchedulerStats stats = scheduler.getStats();
+			
+			out += "# TYPE chartboost_scheduler_queue_depth gauge\n";
+			appendf(out, "chartboost_scheduler_queue_depth{state=\"pending\"} %d\n", scheduler.getPendingCount());
+			appendf(out, "chartboost_scheduler_queue_depth{state=\"in_flight\"} %d\n", scheduler.getInFlightCount());
+			
+			out += "# TYPE chartboost_scheduler_requests counter\n";
+			appendf(out, "chartboost_scheduler_requests_total{result=\"requested\"} %d\n", stats.requested);
+			appendf(out, "chartboost_scheduler_requests_total{result=\"issued\"} %d\n", stats.issued);
+			appendf(out, "chartboost_scheduler_requests_total{result=\"urgent_issued\"} %d\n", stats.urgentIssued);
+			appendf(out, "chartboost_scheduler_requests_total{result=\"issued_outside_idle\"} %d\n", stats.issuedOutsideIdle);
+			appendf(out, "chartboost_scheduler_requests_total{result=\"succeeded\"} %d\n", stats.succeeded);
+			appendf(out, "chartboost_scheduler_requests_total{result=\"failed\"} %d\n", stats.failed);
+			appendf(out, "chartboost_scheduler_requests_total{result=\"already_cached\"} %d\n", stats.alreadyCached);
+			
+			out += "# TYPE chartboost_scheduler_retries counter\n";
+			appendf(out, "chartboost_scheduler_retries_total %d\n", stats.retries);
+			out += "# TYPE chartboost_scheduler_timeouts counter\n";
+			appendf(out, "chartboost_scheduler_timeouts_total %d\n", stats.timeouts);
+			
+			out += "# TYPE chartboost_scheduler_queue_seconds counter\n";
+			appendf(out, "chartboost_scheduler_queue_seconds_total %.6f\n", stats.totalQueueTime);
+			out += "# TYPE chartboost_scheduler_cache_seconds counter\n";
+			appendf(out, "chartboost_scheduler_cache_seconds_total %.6f\n", stats.totalCacheTime);
+		}
+		
+		void runExport(int generation)
+		{
+			std::unique_lock<std::mutex> lock(exportMutex);
+			while(exportRunning && exportGeneration == generation) {
+				exportWake.wait_for(lock, std::chrono::duration<double>(exportInterval));
+				if(!exportRunning || exportGeneration != generation) {
+					break;
+				}
+				
+				std::string path = exportPath;
+				const Scheduler* scheduler = exportScheduler;
+				lock.unlock();
+				writeOpenMetricsFile(path.c_str(), scheduler);
+				lock.lock();
+			}
+		}
+	}
+	
+	std::string getOpenMetricsText(const Scheduler* scheduler)
+	{
+		std::string out;
+		
+		out += "# TYPE chartboost_errors counter\n";
+		out += "# HELP chartboost_errors Errors reported by the SDK, by stable error code.\n";
+		for(int code = 0; code < ERROR_CODE_COUNT; code++) {
+			appendf(out, "chartboost_errors_total{code=\"%s\"} %d\n", getErrorName(code), getErrorCount(code));
+		}
+		
+		out += "# TYPE chartboost_dropped_events counter\n";
+		out += "# HELP chartboost_dropped_events Events dropped because the event ring was full.\n";
+		appendf(out, "chartboost_dropped_events_total %d\n", getDroppedEventCount());
+		
+		out += "# TYPE chartboost_illegal_transitions counter\n";
+		appendf(out, "chartboost_illegal_transitions_total %d\n", getIllegalTransitionCount());
+		
+		StallStats stalls = getStallStats();
+		out += "# TYPE chartboost_sdk_calls counter\n";
+		appendf(out, "chartboost_sdk_calls_total %d\n", stalls.calls);
+		out += "# TYPE chartboost_sdk_stalls counter\n";
+		appendf(out, "chartboost_sdk_stalls_total{kind=\"stall\"} %d\n", stalls.stalls);
+		appendf(out, "chartboost_sdk_stalls_total{kind=\"hang\"} %d\n", stalls.hangs);
+		
+		appendLocationMetrics(out);
+		appendMemoryMetrics(out);
+		if(scheduler != NULL) {
+			appendSchedulerMetrics(out, *scheduler);
+		}
+		
+		out += "# EOF\n";
+		return out;
+	}
+	
+	bool writeOpenMetricsFile(const char* path, const Scheduler* scheduler)
+	{
+		std::string text = getOpenMetricsText(scheduler);
+		std::string temporaryPath = std::string(path) + ".tmp";
+		
+		FILE* file = fopen(temporaryPath.c_str(), "wb");
+		if(file == NULL) {
+			return false;
+		}
+		bool written = fwrite(text.data(), 1, text.size(), file) == text.size();
+		written = fclose(file) == 0 && written;
+		if(!written || rename(temporaryPath.c_str(), path) != 0) {
+			remove(temporaryPath.c_str());
+			return false;
+		}
+		return true;
+	}
+	
+	void startMetricsExport(const char* path, double interval, const Scheduler* scheduler)
+	{
+		std::lock_guard<std::mutex> lock(exportMutex);
+		exportPath = path;
+		exportInterval = interval > 0.0 ? interval : 10.0;
+		exportScheduler = scheduler;
+		exportGeneration++;
+		exportRunning = true;
+		exportWake.notify_all();
+		std::thread(runExport, exportGeneration).detach();
+	}
+	
+	void stopMetricsExport()
+	{
+		std::lock_guard<std::mutex> lock(exportMutex);
+		exportGeneration++;
+		exportRunning = false;
+		exportWake.notify_all();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,205 @@
+#include "ChartboostPredictor.h"
+#include "ChartboostScheduler.h"
+
+namespace samcodeschartboost
+{
+	PredictorPolicy::PredictorPolicy() : safetyFactor(2.0), defaultCacheTime(5.0), smoothing(0.3)
+	{
+	}
+	
+	Predictor::Predictor(Scheduler& scheduler) : scheduler(scheduler), issuedCount(0)
+	{
+		scheduler.setObserver(this);
+	}
+	
+	Predictor::~Predictor()
+	{
+		scheduler.setObserver(NULL);
+	}
+	
+	void Predictor::setPolicy(const PredictorPolicy& newPolicy)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		policy = newPolicy;
+	}
+	
+	PredictorPolicy Predictor::getPolicy() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return policy;
+	}
+	
+	void Predictor::watchPlacement(int adType, const char* location, int stepsPerShow, int maxShows, double now)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		int index = findPlacement(adType, location);
+		if(index >= 0) {
+			placements[index].stepsPerShow = stepsPerShow;
+			placements[index].maxShows = maxShows;
+			return;
+		}
+		
+		Placement placement;
+		placement.adType = adType;
+		placement.location = location;
+		placement.stepsPerShow = stepsPerShow;
+		placement.maxShows = maxShows;
+		placement.shows = 0;
+		placement.stepsSinceShow = 0;
+		placement.lastStepAt = now;
+		placement.stepTime = 0.0;
+		placement.cacheTime = 0.0;
+		placement.requestedAt = 0.0;
+		placement.requested = false;
+		placement.cached = false;
+		placements.push_back(placement);
+	}
+	
+	void Predictor::unwatchPlacement(int adType, const char* location)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		int index = findPlacement(adType, location);
+		if(index >= 0) {
+			placements.erase(placements.begin() + index);
+		}
+	}
+	
+	void Predictor::reportStep(int adType, const char* location, double now)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		int index = findPlacement(adType, location);
+		if(index < 0) {
+			return;
+		}
+		
+		Placement& placement = placements[index];
+		double elapsed = now - placement.lastStepAt;
+		placement.stepTime = placement.stepTime == 0.0 ? elapsed : placement.stepTime + (elapsed - placement.stepTime) * policy.smoothing;
+		placement.lastStepAt = now;
+		placement.stepsSinceShow++;
+	}
+	
+	void Predictor::onShown(int adType, const char* location, double now)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		int index = findPlacement(adType, location);
+		if(index < 0) {
+			return;
+		}
+		
+		Placement& placement = placements[index];
+		placement.shows++;
+		placement.stepsSinceShow = 0;
+		placement.lastStepAt = now;
+		placement.requested = false;
+		placement.cached = false;
+	}
+	
+	void Predictor::onCacheFinished(int adType, const char* location, bool success, double now)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		int index = findPlacement(adType, location);
+		if(index < 0 || !success) {
+			// Failed requests are left to the scheduler's retries, if it gives up onRequestDropped lets the placement be requested again
+			return;
+		}
+		
+		Placement& placement = placements[index];
+		if(placement.requested && !placement.cached) {
+			double elapsed = now - placement.requestedAt;
+			placement.cacheTime = placement.cacheTime == 0.0 ? elapsed : placement.cacheTime + (elapsed - placement.cacheTime) * policy.smoothing;
+		}
+		placement.cached = true;
+	}
+	
+	void Predictor::onRequestDropped(int adType, const char* location, double)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		int index = findPlacement(adType, location);
+		if(index >= 0 && !placements[index].cached) {
+			placements[index].requested = false;
+		}
+	}
+	
+	void Predictor::update(double now)
+	{
+		std::vector<Placement> due;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			for(size_t i = 0; i < placements.size(); i++) {
+				Placement& placement = placements[i];
+				if(isDue(placement, now)) {
+					placement.requested = true;
+					placement.requestedAt = now;
+					issuedCount++;
+					due.push_back(placement);
+				}
+			}
+		}
+		
+		// The scheduler may call into the SDK, which can report back into the predictor, so this happens without the mutex held.
+		// Requests are urgent since waiting for an idle window would defeat the timing
+		for(size_t i = 0; i < due.size(); i++) {
+			scheduler.request(due[i].adType, due[i].location.c_str(), true, now);
+		}
+	}
+	
+	double Predictor::getTimeToShow(int adType, const char* location, double now) const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		int index = findPlacement(adType, location);
+		if(index < 0) {
+			return -1.0;
+		}
+		const Placement& placement = placements[index];
+		if(placement.maxShows > 0 && placement.shows >= placement.maxShows) {
+			return -1.0;
+		}
+		return timeToShow(placement, now);
+	}
+	
+	int Predictor::getIssuedCount() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return issuedCount;
+	}
+	
+	int Predictor::findPlacement(int adType, const char* location) const
+	{
+		for(size_t i = 0; i < placements.size(); i++) {
+			if(placements[i].adType == adType && placements[i].location == location) {
+				return (int)i;
+			}
+		}
+		return -1;
+	}
+	
+	bool Predictor::isDue(const Placement& placement, double now) const
+	{
+		if(placement.requested || placement.cached) {
+			return false;
+		}
+		if(placement.maxShows > 0 && placement.shows >= placement.maxShows) {
+			return false;
+		}
+		
+		double remaining = timeToShow(placement, now);
+		if(remaining < 0.0) {
+			// Without a step time yet, fall back to requesting on the last step before the show
+			return placement.stepsSinceShow + 1 >= placement.stepsPerShow;
+		}
+		
+		double cacheTime = placement.cacheTime > 0.0 ? placement.cacheTime : policy.defaultCacheTime;
+		return remaining <= cacheTime * policy.safetyFactor;
+	}
+	
+	double Predictor::timeToShow(const Placement& placement, double now) const
+	{
+		if(placement.stepTime <= 0.0) {
+			return -1.0;
+		}
+		int stepsLeft = placement.stepsPerShow - placement.stepsSinceShow;
+		double remaining = stepsLeft * placement.stepTime - (now - placement.lastStepAt);
+		return remaining > 0.0 ? remaining : 0.0;
+	}
+}
\ No newline at end of file
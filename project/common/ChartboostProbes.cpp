@@ -0,0 +1,14 @@
+#include "ChartboostProbes.h"
+
+#ifdef SAMCODESCHARTBOOST_HAVE_PROBES
+
+// Tracers enable a probe by incrementing its semaphore, which sys/sdt.h finds by name in the .probes section
+extern "C"
+{
+	__attribute__((section(".probes"))) volatile unsigned short samcodeschartboost_event_enqueue_semaphore = 0;
+	__attribute__((section(".probes"))) volatile unsigned short samcodeschartboost_event_deliver_semaphore = 0;
+	__attribute__((section(".probes"))) volatile unsigned short samcodeschartboost_command_issue_semaphore = 0;
+	__attribute__((section(".probes"))) volatile unsigned short samcodeschartboost_command_complete_semaphore = 0;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,318 @@
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ChartboostPurchases.h"
+#include "SamcodesChartboost.h"
+
+namespace samcodeschartboost
+{
+	namespace
+	{
+		// Queue file layout: a fixed header, then records from head to tail. Each record is a 4 byte length followed by
+		// a flags byte and then the receipt, title, description, price, currency and product id, each with a 4 byte length
+		struct QueueHeader
+		{
+			unsigned int magic;
+			unsigned int version;
+			unsigned int head;
+			unsigned int tail;
+			unsigned int count;
+		};
+		
+		const unsigned int queueMagic = 0x51504243; // "CBPQ"
+		const unsigned int queueVersion = 1;
+		const unsigned int initialQueueCapacity = 16 * 1024;
+		const unsigned char receiptIsBase64Flag = 1;
+		
+		std::mutex queueMutex;
+		int queueFile = -1;
+		unsigned char* queueData = NULL;
+		unsigned int queueCapacity = 0;
+		bool queueOpenFailed = false;
+		
+		std::atomic<bool> trackingReady(false);
+		std::atomic<bool> trackingOnline(false);
+		std::atomic<bool> draining(false);
+		
+		QueueHeader* getHeader()
+		{
+			return reinterpret_cast<QueueHeader*>(queueData);
+		}
+		
+		bool mapQueue(unsigned int capacity)
+		{
+			if(queueData != NULL) {
+				munmap(queueData, queueCapacity);
+				queueData = NULL;
+			}
+			if(ftruncate(queueFile, capacity) != 0) {
+				return false;
+			}
+			void* data = mmap(NULL, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, queueFile, 0);
+			if(data == MAP_FAILED) {
+				return false;
+			}
+			queueData = static_cast<unsigned char*>(data);
+			queueCapacity = capacity;
+			return true;
+		}
+		
+		// Drops everything queued, for a header or record that can't be trusted. Must be called with the queue mutex held
+		void resetQueue()
+		{
+			QueueHeader* header = getHeader();
+			header->magic = queueMagic;
+			header->version = queueVersion;
+			header->head = sizeof(QueueHeader);
+			header->tail = sizeof(QueueHeader);
+			header->count = 0;
+		}
+		
+		// Opens the queue file on first use, must be called with the queue mutex held
+		bool openQueue()
+		{
+			if(queueData != NULL) {
+				return true;
+			}
+			if(queueOpenFailed) {
+				return false;
+			}
+			
+			std::string path = getStoragePath("samcodeschartboost_purchases.bin");
+			queueFile = open(path.c_str(), O_RDWR | O_CREAT, 0600);
+			if(queueFile < 0) {
+				queueOpenFailed = true;
+				return false;
+			}
+			
+			struct stat info;
+			unsigned int capacity = initialQueueCapacity;
+			if(fstat(queueFile, &info) == 0 && info.st_size > (off_t)capacity) {
+				capacity = (unsigned int)info.st_size;
+			}
+			if(!mapQueue(capacity)) {
+				close(queueFile);
+				queueFile = -1;
+				queueOpenFailed = true;
+				return false;
+			}
+			
+			// A new or unreadable file starts as an empty queue
+			QueueHeader* header = getHeader();
+			if(header->magic != queueMagic || header->version != queueVersion || header->head < sizeof(QueueHeader) || header->head > header->tail || header->tail > queueCapacity) {
+				resetQueue();
+			}
+			return true;
+		}
+		
+		// Moves the unsent records to the front of the file once the sent ones take up most of it
+		void compactQueue()
+		{
+			QueueHeader* header = getHeader();
+			unsigned int used = header->tail - header->head;
+			if(header->head - sizeof(QueueHeader) < used && header->head < queueCapacity / 2) {
+				return;
+			}
+			memmove(queueData + sizeof(QueueHeader), queueData + header->head, used);
+			header->head = sizeof(QueueHeader);
+			header->tail = sizeof(QueueHeader) + used;
+		}
+		
+		void writeField(unsigned char*& out, const void* data, unsigned int length)
+		{
+			memcpy(out, &length, sizeof(length));
+			out += sizeof(length);
+			memcpy(out, data, length);
+			out += length;
+		}
+		
+		// Reads a field that must end by the end of its record, returning false if the length says otherwise
+		bool readField(const unsigned char*& in, const unsigned char* end, std::string& field)
+		{
+			unsigned int length;
+			if((size_t)(end - in) < sizeof(length)) {
+				return false;
+			}
+			memcpy(&length, in, sizeof(length));
+			in += sizeof(length);
+			if((size_t)(end - in) < length) {
+				return false;
+			}
+			field.assign(reinterpret_cast<const char*>(in), length);
+			in += length;
+			return true;
+		}
+		
+		std::string encodeBase64(const std::string& data)
+		{
+			static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+			std::string encoded;
+			encoded.reserve(((data.size() + 2) / 3) * 4);
+			size_t i = 0;
+			for(; i + 2 < data.size(); i += 3) {
+				unsigned int n = ((unsigned char)data[i] << 16) | ((unsigned char)data[i + 1] << 8) | (unsigned char)data[i + 2];
+				encoded.push_back(alphabet[(n >> 18) & 63]);
+				encoded.push_back(alphabet[(n >> 12) & 63]);
+				encoded.push_back(alphabet[(n >> 6) & 63]);
+				encoded.push_back(alphabet[n & 63]);
+			}
+			if(i < data.size()) {
+				unsigned int n = (unsigned char)data[i] << 16;
+				if(i + 1 < data.size()) {
+					n |= (unsigned char)data[i + 1] << 8;
+				}
+				encoded.push_back(alphabet[(n >> 18) & 63]);
+				encoded.push_back(alphabet[(n >> 12) & 63]);
+				encoded.push_back(i + 1 < data.size() ? alphabet[(n >> 6) & 63] : '=');
+				encoded.push_back('=');
+			}
+			return encoded;
+		}
+		
+		void drainQueue()
+		{
+			while(trackingReady.load() && trackingOnline.load()) {
+				unsigned char flags;
+				std::string receipt, title, description, price, currency, productId;
+				unsigned int recordLength;
+				{
+					std::lock_guard<std::mutex> lock(queueMutex);
+					if(!openQueue() || getHeader()->head == getHeader()->tail) {
+						break;
+					}
+					
+					// The file outlives the process, so a torn write or a corrupt file must not send reads past the tail.
+					// A record that doesn't fit is dropped along with everything after it, as a bad header is on open
+					QueueHeader* header = getHeader();
+					const unsigned char* in = queueData + header->head;
+					const unsigned char* tail = queueData + header->tail;
+					bool valid = (size_t)(tail - in) >= sizeof(recordLength) + 1;
+					if(valid) {
+						memcpy(&recordLength, in, sizeof(recordLength));
+						in += sizeof(recordLength);
+						valid = recordLength >= 1 && recordLength <= (size_t)(tail - in);
+					}
+					if(valid) {
+						const unsigned char* end = in + recordLength;
+						flags = *in++;
+						valid = readField(in, end, receipt) && readField(in, end, title) && readField(in, end, description)
+							&& readField(in, end, price) && readField(in, end, currency) && readField(in, end, productId);
+					}
+					if(!valid) {
+						resetQueue();
+						break;
+					}
+				}
+				
+				// Encoding and the SDK call happen without the lock held, so the game thread can keep queueing.
+				// A record whose price the bridge can't parse would never send, so it's removed whether or not it was sent
+				if((flags & receiptIsBase64Flag) == 0) {
+					receipt = encodeBase64(receipt);
+				}
+				sendPurchase(receipt.c_str(), title.c_str(), description.c_str(), price.c_str(), currency.c_str(), productId.c_str());
+				
+				{
+					std::lock_guard<std::mutex> lock(queueMutex);
+					QueueHeader* header = getHeader();
+					header->head += sizeof(recordLength) + recordLength;
+					header->count--;
+					compactQueue();
+				}
+			}
+		}
+		
+		void startDrain()
+		{
+			if(!trackingReady.load() || !trackingOnline.load()) {
+				return;
+			}
+			if(draining.exchange(true)) {
+				return;
+			}
+			std::thread([]() {
+				// Anything queued after the drain loop finished but before the flag was cleared is picked up by going round again
+				do {
+					drainQueue();
+					draining.store(false);
+				} while(getQueuedPurchaseCount() > 0 && trackingReady.load() && trackingOnline.load() && !draining.exchange(true));
+			}).detach();
+		}
+	}
+	
+	void queuePurchase(const unsigned char* receipt, int receiptLength, bool receiptIsBase64, const char* title, const char* description, const char* price, const char* currency, const char* productId)
+	{
+		{
+			std::lock_guard<std::mutex> lock(queueMutex);
+			if(!openQueue()) {
+				return;
+			}
+			
+			const char* strings[] = { title, description, price, currency, productId };
+			unsigned int recordLength = 1 + sizeof(unsigned int) + (unsigned int)receiptLength;
+			for(int i = 0; i < 5; i++) {
+				recordLength += sizeof(unsigned int) + (unsigned int)strlen(strings[i]);
+			}
+			
+			unsigned int required = getHeader()->tail + sizeof(recordLength) + recordLength;
+			if(required > queueCapacity) {
+				compactQueue();
+				required = getHeader()->tail + sizeof(recordLength) + recordLength;
+				unsigned int capacity = queueCapacity;
+				while(capacity < required) {
+					capacity *= 2;
+				}
+				if(capacity != queueCapacity && !mapQueue(capacity)) {
+					close(queueFile);
+					queueFile = -1;
+					queueOpenFailed = true;
+					return;
+				}
+			}
+			
+			// The record is written before the tail moves past it, so a partly written record is never read back
+			QueueHeader* header = getHeader();
+			unsigned char* out = queueData + header->tail;
+			memcpy(out, &recordLength, sizeof(recordLength));
+			out += sizeof(recordLength);
+			*out++ = receiptIsBase64 ? receiptIsBase64Flag : 0;
+			writeField(out, receipt, (unsigned int)receiptLength);
+			for(int i = 0; i < 5; i++) {
+				writeField(out, strings[i], (unsigned int)strlen(strings[i]));
+			}
+			header->tail = required;
+			header->count++;
+		}
+		
+		startDrain();
+	}
+	
+	int getQueuedPurchaseCount()
+	{
+		std::lock_guard<std::mutex> lock(queueMutex);
+		if(!openQueue()) {
+			return 0;
+		}
+		return (int)getHeader()->count;
+	}
+	
+	void setPurchaseTrackingReady(bool ready)
+	{
+		trackingReady.store(ready);
+		startDrain();
+	}
+	
+	void setPurchaseTrackingOnline(bool online)
+	{
+		if(trackingOnline.exchange(online) != online) {
+			startDrain();
+		}
+	}
+}
\ No newline at end of file
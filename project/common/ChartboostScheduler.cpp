@@ -0,0 +1,278 @@
+#include "ChartboostErrors.h"
+#include "ChartboostLocations.h"
+#include "ChartboostProbes.h"
+#include "ChartboostScheduler.h"
+
+namespace samcodeschartboost
+{
+	SchedulerPolicy::SchedulerPolicy() : maxInFlight(1), maxRetries(3), retryBackoff(5.0), requestTimeout(30.0), deferOutsideIdle(true)
+	{
+	}
+	
+	Scheduler::Scheduler(SchedulerSink* sink) : sink(sink), observer(NULL), stats(), idleDepth(0)
+	{
+	}
+	
+	void Scheduler::setPolicy(const SchedulerPolicy& newPolicy)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		policy = newPolicy;
+	}
+	
+	SchedulerPolicy Scheduler::getPolicy() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return policy;
+	}
+	
+	void Scheduler::setObserver(SchedulerObserver* newObserver)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		observer = newObserver;
+	}
+	
+	void Scheduler::request(int adType, const char* location, bool urgent, double now)
+	{
+		std::vector<Request> issues;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stats.requested++;
+			
+			int index = findRequest(adType, location);
+			if(index >= 0) {
+				Request& existing = requests[index];
+				if(urgent && !existing.urgent) {
+					existing.urgent = true;
+					existing.notBefore = now;
+				}
+			} else {
+				Request request;
+				request.adType = adType;
+				request.location = location;
+				request.urgent = urgent;
+				request.inFlight = false;
+				request.attempts = 0;
+				request.requestedAt = now;
+				request.issuedAt = 0.0;
+				request.notBefore = now;
+				requests.push_back(request);
+			}
+			collectIssues(now, issues);
+		}
+		issue(issues, now);
+	}
+	
+	void Scheduler::beginIdleWindow(double now)
+	{
+		std::vector<Request> issues;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			idleDepth++;
+			collectIssues(now, issues);
+		}
+		issue(issues, now);
+	}
+	
+	// Ending a window never issues anything, so the time is only part of the signature to match beginIdleWindow
+	void Scheduler::endIdleWindow(double)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if(idleDepth > 0) {
+			idleDepth--;
+		}
+	}
+	
+	bool Scheduler::isIdle() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return idleDepth > 0;
+	}
+	
+	void Scheduler::onCacheFinished(int adType, const char* location, bool success, int errorCode, double now)
+	{
+		std::vector<Request> issues;
+		std::vector<Request> dropped;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			
+			// Results for placements the game cached directly, rather than through the scheduler, are ignored
+			int index = findRequest(adType, location);
+			if(index < 0 || !requests[index].inFlight) {
+				return;
+			}
+			
+			stats.totalCacheTime += now - requests[index].issuedAt;
+			if(SCB_PROBE_ENABLED(command_complete)) {
+				SCB_PROBE4(command_complete, adType, internLocation(location), success ? -1 : errorCode, SCB_PROBE_NANOSECONDS(now - requests[index].issuedAt));
+			}
+			if(success) {
+				stats.succeeded++;
+				requests.erase(requests.begin() + index);
+			} else if(isErrorRetryable(errorCode)) {
+				retryOrDrop(index, now, dropped);
+			} else {
+				drop(index, dropped);
+			}
+			collectIssues(now, issues);
+		}
+		notifyDropped(dropped, now);
+		issue(issues, now);
+	}
+	
+	void Scheduler::update(double now)
+	{
+		std::vector<Request> issues;
+		std::vector<Request> dropped;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			for(size_t i = requests.size(); i-- > 0;) {
+				if(requests[i].inFlight && now - requests[i].issuedAt >= policy.requestTimeout) {
+					stats.timeouts++;
+					retryOrDrop(i, now, dropped);
+				}
+			}
+			collectIssues(now, issues);
+		}
+		notifyDropped(dropped, now);
+		issue(issues, now);
+	}
+	
+	int Scheduler::getPendingCount() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		int pending = 0;
+		for(size_t i = 0; i < requests.size(); i++) {
+			if(!requests[i].inFlight) {
+				pending++;
+			}
+		}
+		return pending;
+	}
+	
+	int Scheduler::getInFlightCount() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		int inFlight = 0;
+		for(size_t i = 0; i < requests.size(); i++) {
+			if(requests[i].inFlight) {
+				inFlight++;
+			}
+		}
+		return inFlight;
+	}
+	
+	SchedulerStats Scheduler::getStats() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return stats;
+	}
+	
+	int Scheduler::findRequest(int adType, const char* location) const
+	{
+		for(size_t i = 0; i < requests.size(); i++) {
+			if(requests[i].adType == adType && requests[i].location == location) {
+				return (int)i;
+			}
+		}
+		return -1;
+	}
+	
+	void Scheduler::retryOrDrop(size_t index, double now, std::vector<Request>& dropped)
+	{
+		Request& request = requests[index];
+		if(request.attempts > policy.maxRetries) {
+			drop(index, dropped);
+			return;
+		}
+		stats.retries++;
+		request.inFlight = false;
+		request.notBefore = now + policy.retryBackoff * (double)(1 << (request.attempts - 1));
+	}
+	
+	// Gives up on a request, keeping it for the observer to hear about once the mutex is released
+	void Scheduler::drop(size_t index, std::vector<Request>& dropped)
+	{
+		stats.failed++;
+		dropped.push_back(requests[index]);
+		requests.erase(requests.begin() + index);
+	}
+	
+	// Marks the requests that may go out now as in flight, urgent ones first. Must be called with the mutex held
+	void Scheduler::collectIssues(double now, std::vector<Request>& issues)
+	{
+		int inFlight = 0;
+		for(size_t i = 0; i < requests.size(); i++) {
+			if(requests[i].inFlight) {
+				inFlight++;
+			}
+		}
+		
+		for(int pass = 0; pass < 2; pass++) {
+			bool urgentPass = pass == 0;
+			for(size_t i = 0; i < requests.size(); i++) {
+				Request& request = requests[i];
+				if(request.inFlight || request.urgent != urgentPass || request.notBefore > now) {
+					continue;
+				}
+				if(!urgentPass && (inFlight >= policy.maxInFlight || (policy.deferOutsideIdle && idleDepth == 0))) {
+					continue;
+				}
+				
+				request.inFlight = true;
+				request.attempts++;
+				request.issuedAt = now;
+				inFlight++;
+				
+				stats.issued++;
+				if(request.urgent) {
+					stats.urgentIssued++;
+				}
+				if(idleDepth == 0) {
+					stats.issuedOutsideIdle++;
+				}
+				if(request.attempts == 1) {
+					stats.totalQueueTime += now - request.requestedAt;
+				}
+				issues.push_back(request);
+			}
+		}
+	}
+	
+	// Talks to the SDK without the mutex held, since the SDK may call back into the scheduler
+	void Scheduler::issue(std::vector<Request>& issues, double now)
+	{
+		for(size_t i = 0; i < issues.size(); i++) {
+			const Request& request = issues[i];
+			if(sink->isCached(request.adType, request.location.c_str())) {
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					stats.alreadyCached++;
+				}
+				onCacheFinished(request.adType, request.location.c_str(), true, ERROR_UNKNOWN, now);
+				continue;
+			}
+			if(SCB_PROBE_ENABLED(command_issue)) {
+				SCB_PROBE2(command_issue, request.adType, internLocation(request.location.c_str()));
+			}
+			sink->issueCache(request.adType, request.location.c_str());
+		}
+	}
+	
+	void Scheduler::notifyDropped(const std::vector<Request>& dropped, double now)
+	{
+		if(dropped.empty()) {
+			return;
+		}
+		SchedulerObserver* current;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			current = observer;
+		}
+		if(current == NULL) {
+			return;
+		}
+		for(size_t i = 0; i < dropped.size(); i++) {
+			current->onRequestDropped(dropped[i].adType, dropped[i].location.c_str(), now);
+		}
+	}
+}
\ No newline at end of file
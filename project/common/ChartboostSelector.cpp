@@ -0,0 +1,173 @@
+#include <cmath>
+
+#include "ChartboostScheduler.h"
+#include "ChartboostSelector.h"
+
+namespace samcodeschartboost
+{
+	Selector::Selector() : latencyScale(5.0), exploration(1.41421356)
+	{
+	}
+	
+	void Selector::setLatencyScale(double seconds)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		latencyScale = seconds;
+	}
+	
+	void Selector::setExploration(double newExploration)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		exploration = newExploration;
+	}
+	
+	void Selector::addCandidate(const char* group, int adType, const char* location)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		int arm = findArm(adType, location);
+		if(arm < 0) {
+			Arm newArm;
+			newArm.adType = adType;
+			newArm.pulls = 0;
+			newArm.rewardSum = 0.0f;
+			newArm.requestedAt = -1.0;
+			arms.push_back(newArm);
+			armLocations.push_back(location);
+			arm = (int)arms.size() - 1;
+		}
+		
+		size_t groupIndex = 0;
+		while(groupIndex < groupNames.size() && groupNames[groupIndex] != group) {
+			groupIndex++;
+		}
+		if(groupIndex == groupNames.size()) {
+			groupNames.push_back(group);
+			groupArms.push_back(std::vector<int>());
+		}
+		
+		std::vector<int>& candidates = groupArms[groupIndex];
+		for(size_t i = 0; i < candidates.size(); i++) {
+			if(candidates[i] == arm) {
+				return;
+			}
+		}
+		candidates.push_back(arm);
+	}
+	
+	void Selector::clearGroup(const char* group)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for(size_t i = 0; i < groupNames.size(); i++) {
+			if(groupNames[i] == group) {
+				groupArms[i].clear();
+				return;
+			}
+		}
+	}
+	
+	std::string Selector::select(const char* group) const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for(size_t g = 0; g < groupNames.size(); g++) {
+			if(groupNames[g] != group) {
+				continue;
+			}
+			
+			const std::vector<int>& candidates = groupArms[g];
+			unsigned int totalPulls = 0;
+			for(size_t i = 0; i < candidates.size(); i++) {
+				totalPulls += arms[candidates[i]].pulls;
+			}
+			
+			// Untried placements go first, in the order they were added
+			int best = -1;
+			double bestScore = 0.0;
+			for(size_t i = 0; i < candidates.size(); i++) {
+				const Arm& arm = arms[candidates[i]];
+				if(arm.pulls == 0) {
+					best = candidates[i];
+					break;
+				}
+				double mean = arm.rewardSum / arm.pulls;
+				double score = mean + exploration * std::sqrt(std::log((double)totalPulls) / arm.pulls);
+				if(best < 0 || score > bestScore) {
+					best = candidates[i];
+					bestScore = score;
+				}
+			}
+			return best < 0 ? std::string() : armLocations[best];
+		}
+		return std::string();
+	}
+	
+	void Selector::onCacheRequested(int adType, const char* location, double now)
+	{
+		double timeout = getScheduler().getPolicy().requestTimeout;
+		std::lock_guard<std::mutex> lock(mutex);
+		expireRequests(now, timeout);
+		int arm = findArm(adType, location);
+		if(arm >= 0) {
+			// Only the latest request can be the one the SDK answers, so the clock starts again on each one
+			arms[arm].requestedAt = now;
+		}
+	}
+	
+	void Selector::onCacheFinished(int adType, const char* location, bool success, double now)
+	{
+		double timeout = getScheduler().getPolicy().requestTimeout;
+		std::lock_guard<std::mutex> lock(mutex);
+		expireRequests(now, timeout);
+		int index = findArm(adType, location);
+		if(index < 0 || arms[index].requestedAt < 0.0) {
+			// Results without a request seen, e.g. from the SDK's own auto caching, can't be timed so aren't counted
+			return;
+		}
+		
+		Arm& arm = arms[index];
+		double reward = 0.0;
+		if(success) {
+			double latency = now - arm.requestedAt;
+			reward = latencyScale / (latencyScale + (latency > 0.0 ? latency : 0.0));
+		}
+		arm.pulls++;
+		arm.rewardSum += (float)reward;
+		arm.requestedAt = -1.0;
+	}
+	
+	int Selector::getPulls(int adType, const char* location) const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		int arm = findArm(adType, location);
+		return arm < 0 ? 0 : (int)arms[arm].pulls;
+	}
+	
+	double Selector::getMeanReward(int adType, const char* location) const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		int arm = findArm(adType, location);
+		if(arm < 0 || arms[arm].pulls == 0) {
+			return 0.0;
+		}
+		return arms[arm].rewardSum / arms[arm].pulls;
+	}
+	
+	void Selector::expireRequests(double now, double timeout)
+	{
+		for(size_t i = 0; i < arms.size(); i++) {
+			if(arms[i].requestedAt >= 0.0 && now - arms[i].requestedAt > timeout) {
+				arms[i].pulls++;
+				arms[i].requestedAt = -1.0;
+			}
+		}
+	}
+	
+	int Selector::findArm(int adType, const char* location) const
+	{
+		for(size_t i = 0; i < arms.size(); i++) {
+			if(arms[i].adType == adType && armLocations[i] == location) {
+				return (int)i;
+			}
+		}
+		return -1;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,339 @@
+#include <cmath>
+
+#include "ChartboostErrors.h"
+#include "ChartboostSimulator.h"
+
+namespace samcodeschartboost
+{
+	namespace
+	{
+		SimulatedPlacement& getScenarioPlacement(SimulatedScenario& scenario, int adType, const std::string& location)
+		{
+			for(size_t i = 0; i < scenario.placements.size(); i++) {
+				if(scenario.placements[i].adType == adType && scenario.placements[i].location == location) {
+					return scenario.placements[i];
+				}
+			}
+			SimulatedPlacement placement;
+			placement.adType = adType;
+			placement.location = location;
+			scenario.placements.push_back(placement);
+			return scenario.placements.back();
+		}
+		
+		bool parseOutcome(const std::string& word, int& outcome)
+		{
+			if(word == "fill") {
+				outcome = OUTCOME_FILL;
+			} else if(word == "lost") {
+				outcome = OUTCOME_LOST;
+			} else {
+				outcome = findErrorCode(word.c_str());
+			}
+			return outcome != ERROR_UNKNOWN;
+		}
+	}
+	
+	SimulatedPlacement::SimulatedPlacement() : adType(0), fillRate(0.8), latency(3.0), latencySpread(1.0), latencyDistribution(LATENCY_UNIFORM), lossRate(0.0), failureCode(ERROR_NO_AD_FOUND)
+	{
+	}
+	
+	SimulatedFaults::SimulatedFaults() : offlineLatency(0.0), reorderRate(0.0), reorderDelay(0.0), duplicateRate(0.0), duplicateDelay(0.0)
+	{
+	}
+	
+	bool isScenarioDirective(const std::string& directive)
+	{
+		return directive == "placement" || directive == "latency" || directive == "failure" || directive == "outcomes"
+			|| directive == "offline" || directive == "offline_latency" || directive == "reorder" || directive == "duplicate";
+	}
+	
+	bool parseScenarioDirective(const std::string& directive, std::istream& in, SimulatedScenario& scenario)
+	{
+		SimulatedFaults& faults = scenario.faults;
+		if(directive == "offline") {
+			OfflinePeriod period;
+			if(!(in >> period.start >> period.end) || period.end < period.start) {
+				return false;
+			}
+			faults.offline.push_back(period);
+			return true;
+		} else if(directive == "offline_latency") {
+			return (bool)(in >> faults.offlineLatency);
+		} else if(directive == "reorder") {
+			return (bool)(in >> faults.reorderRate >> faults.reorderDelay);
+		} else if(directive == "duplicate") {
+			return (bool)(in >> faults.duplicateRate >> faults.duplicateDelay);
+		}
+		
+		int adType;
+		std::string location;
+		if(!(in >> adType >> location)) {
+			return false;
+		}
+		SimulatedPlacement& placement = getScenarioPlacement(scenario, adType, location);
+		
+		if(directive == "placement") {
+			if(!(in >> placement.fillRate >> placement.latency >> placement.latencySpread)) {
+				return false;
+			}
+			if(!(in >> placement.lossRate)) {
+				placement.lossRate = 0.0;
+			}
+			return true;
+		} else if(directive == "latency") {
+			std::string distribution;
+			if(!(in >> distribution >> placement.latency >> placement.latencySpread)) {
+				return false;
+			}
+			if(distribution == "uniform") {
+				placement.latencyDistribution = LATENCY_UNIFORM;
+			} else if(distribution == "exponential") {
+				placement.latencyDistribution = LATENCY_EXPONENTIAL;
+			} else if(distribution == "lognormal") {
+				placement.latencyDistribution = LATENCY_LOGNORMAL;
+			} else {
+				return false;
+			}
+			return true;
+		} else if(directive == "failure") {
+			std::string name;
+			if(!(in >> name)) {
+				return false;
+			}
+			placement.failureCode = findErrorCode(name.c_str());
+			return placement.failureCode != ERROR_UNKNOWN;
+		} else if(directive == "outcomes") {
+			std::string word;
+			while(in >> word) {
+				int outcome;
+				if(!parseOutcome(word, outcome)) {
+					return false;
+				}
+				placement.outcomes.push_back(outcome);
+			}
+			return true;
+		}
+		return false;
+	}
+	
+	SimulatedSdk::SimulatedSdk(unsigned int seed) : scheduler(NULL), random(seed), stats(), now(0.0)
+	{
+	}
+	
+	void SimulatedSdk::setScheduler(Scheduler* newScheduler)
+	{
+		scheduler = newScheduler;
+	}
+	
+	void SimulatedSdk::addPlacement(const SimulatedPlacement& placement)
+	{
+		placements.push_back(placement);
+		outcomeCursors.push_back(0);
+	}
+	
+	void SimulatedSdk::setDefaultPlacement(const SimulatedPlacement& placement)
+	{
+		defaultPlacement = placement;
+	}
+	
+	void SimulatedSdk::setFaults(const SimulatedFaults& newFaults)
+	{
+		faults = newFaults;
+	}
+	
+	void SimulatedSdk::setScenario(const SimulatedScenario& scenario)
+	{
+		for(size_t i = 0; i < scenario.placements.size(); i++) {
+			addPlacement(scenario.placements[i]);
+		}
+		setFaults(scenario.faults);
+	}
+	
+	double SimulatedSdk::getTime() const
+	{
+		return now;
+	}
+	
+	void SimulatedSdk::advance(double until)
+	{
+		// Answers can cause the scheduler to issue new requests, so the next answer is looked up fresh each time
+		while(!answers.empty() && answers.front().time <= until) {
+			Answer answer = answers.front();
+			answers.erase(answers.begin());
+			now = answer.time;
+			
+			// A duplicate only repeats the callback
+			if(!answer.duplicate && answer.success) {
+				stats.fills++;
+				Cached entry;
+				entry.adType = answer.adType;
+				entry.location = answer.location;
+				cached.push_back(entry);
+			} else if(!answer.duplicate) {
+				stats.failures++;
+			}
+			if(scheduler != NULL) {
+				scheduler->onCacheFinished(answer.adType, answer.location.c_str(), answer.success, answer.errorCode, now);
+			}
+		}
+		if(until > now) {
+			now = until;
+		}
+	}
+	
+	void SimulatedSdk::issueCache(int adType, const char* location)
+	{
+		stats.cacheRequests++;
+		if(findCached(adType, location) >= 0 || isLoading(adType, location)) {
+			stats.duplicateRequests++;
+			return;
+		}
+		
+		int placementIndex = findPlacement(adType, location);
+		const SimulatedPlacement& placement = placementIndex >= 0 ? placements[placementIndex] : defaultPlacement;
+		std::uniform_real_distribution<double> unit(0.0, 1.0);
+		
+		int outcome;
+		double delay;
+		if(isOffline()) {
+			stats.offlineFailures++;
+			outcome = ERROR_INTERNET_UNAVAILABLE;
+			delay = faults.offlineLatency;
+		} else {
+			outcome = nextOutcome(placementIndex, placement);
+			delay = sampleLatency(placement);
+		}
+		if(outcome == OUTCOME_LOST) {
+			stats.lost++;
+			return;
+		}
+		
+		Answer answer;
+		answer.adType = adType;
+		answer.location = location;
+		answer.success = outcome == OUTCOME_FILL;
+		answer.errorCode = answer.success ? ERROR_UNKNOWN : outcome;
+		answer.duplicate = false;
+		answer.time = now + delay;
+		if(faults.reorderRate > 0.0 && unit(random) < faults.reorderRate) {
+			stats.reorderedAnswers++;
+			answer.time += unit(random) * faults.reorderDelay;
+		}
+		insertAnswer(answer);
+		
+		if(faults.duplicateRate > 0.0 && unit(random) < faults.duplicateRate) {
+			stats.duplicatedAnswers++;
+			answer.duplicate = true;
+			answer.time += faults.duplicateDelay;
+			insertAnswer(answer);
+		}
+	}
+	
+	bool SimulatedSdk::isCached(int adType, const char* location)
+	{
+		return findCached(adType, location) >= 0;
+	}
+	
+	bool SimulatedSdk::show(int adType, const char* location)
+	{
+		stats.shows++;
+		int index = findCached(adType, location);
+		if(index < 0) {
+			return false;
+		}
+		cached.erase(cached.begin() + index);
+		stats.showsAvailable++;
+		return true;
+	}
+	
+	int SimulatedSdk::getUnshownCount() const
+	{
+		return (int)cached.size();
+	}
+	
+	const SimulatorStats& SimulatedSdk::getStats() const
+	{
+		return stats;
+	}
+	
+	int SimulatedSdk::findPlacement(int adType, const char* location) const
+	{
+		for(size_t i = 0; i < placements.size(); i++) {
+			if(placements[i].adType == adType && placements[i].location == location) {
+				return (int)i;
+			}
+		}
+		return -1;
+	}
+	
+	int SimulatedSdk::findCached(int adType, const char* location) const
+	{
+		for(size_t i = 0; i < cached.size(); i++) {
+			if(cached[i].adType == adType && cached[i].location == location) {
+				return (int)i;
+			}
+		}
+		return -1;
+	}
+	
+	bool SimulatedSdk::isLoading(int adType, const char* location) const
+	{
+		for(size_t i = 0; i < answers.size(); i++) {
+			if(!answers[i].duplicate && answers[i].adType == adType && answers[i].location == location) {
+				return true;
+			}
+		}
+		return false;
+	}
+	
+	bool SimulatedSdk::isOffline() const
+	{
+		for(size_t i = 0; i < faults.offline.size(); i++) {
+			if(now >= faults.offline[i].start && now < faults.offline[i].end) {
+				return true;
+			}
+		}
+		return false;
+	}
+	
+	int SimulatedSdk::nextOutcome(int placementIndex, const SimulatedPlacement& placement)
+	{
+		if(placementIndex >= 0 && outcomeCursors[placementIndex] < placement.outcomes.size()) {
+			return placement.outcomes[outcomeCursors[placementIndex]++];
+		}
+		std::uniform_real_distribution<double> unit(0.0, 1.0);
+		if(unit(random) < placement.lossRate) {
+			return OUTCOME_LOST;
+		}
+		return unit(random) < placement.fillRate ? OUTCOME_FILL : placement.failureCode;
+	}
+	
+	double SimulatedSdk::sampleLatency(const SimulatedPlacement& placement)
+	{
+		double delay;
+		if(placement.latencyDistribution == LATENCY_EXPONENTIAL && placement.latency > 0.0) {
+			std::exponential_distribution<double> exponential(1.0 / placement.latency);
+			delay = exponential(random);
+		} else if(placement.latencyDistribution == LATENCY_LOGNORMAL && placement.latency > 0.0) {
+			// Parameterized so the mean comes out as the placement's latency
+			double sigma = placement.latencySpread;
+			std::lognormal_distribution<double> lognormal(std::log(placement.latency) - sigma * sigma / 2.0, sigma);
+			delay = lognormal(random);
+		} else {
+			std::uniform_real_distribution<double> unit(0.0, 1.0);
+			delay = placement.latency + (unit(random) * 2.0 - 1.0) * placement.latencySpread;
+		}
+		return delay > 0.0 ? delay : 0.0;
+	}
+	
+	// Answers due at the same time keep the order they were made in
+	void SimulatedSdk::insertAnswer(const Answer& answer)
+	{
+		std::vector<Answer>::iterator it = answers.begin();
+		while(it != answers.end() && it->time <= answer.time) {
+			++it;
+		}
+		answers.insert(it, answer);
+	}
+}
\ No newline at end of file
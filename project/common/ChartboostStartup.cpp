@@ -0,0 +1,88 @@
+#include <mutex>
+
+#include "ChartboostClock.h"
+#include "ChartboostLocations.h"
+#include "ChartboostStartup.h"
+#include "ChartboostText.h"
+#include "SamcodesChartboost.h"
+
+namespace samcodeschartboost
+{
+	namespace
+	{
+		const char* milestoneNames[STARTUP_MILESTONE_COUNT] = { "ndll_loaded", "prime_loader_init", "bindings_resolved", "init_enter", "init_exit", "sdk_started", "did_initialize" };
+		const char* adTypeNames[AD_TYPE_COUNT] = { "interstitial", "rewarded_video" };
+		
+		std::mutex startupMutex;
+		double milestones[STARTUP_MILESTONE_COUNT];
+		bool reached[STARTUP_MILESTONE_COUNT];
+		
+		struct FirstCache
+		{
+			int adType;
+			int location;
+			double time;
+		};
+		
+		FirstCache firstCaches[AD_TYPE_COUNT * MAX_LOCATIONS];
+		int firstCacheCount = 0;
+		bool cached[AD_TYPE_COUNT][MAX_LOCATIONS];
+		
+		// Runs while the ndll's static initializers do, which is as close to the load as native code gets
+		struct NdllLoadMarker
+		{
+			NdllLoadMarker()
+			{
+				markStartupMilestone(STARTUP_NDLL_LOADED, getMonotonicTime());
+			}
+		};
+		
+		NdllLoadMarker ndllLoadMarker;
+	}
+	
+	void markStartupMilestone(int milestone, double time)
+	{
+		if(milestone < 0 || milestone >= STARTUP_MILESTONE_COUNT) {
+			return;
+		}
+		std::lock_guard<std::mutex> lock(startupMutex);
+		if(!reached[milestone]) {
+			reached[milestone] = true;
+			milestones[milestone] = time;
+		}
+	}
+	
+	void markFirstCache(int adType, const char* location, double time)
+	{
+		int index = internLocation(location);
+		if(adType < 0 || adType >= AD_TYPE_COUNT || index < 0) {
+			return;
+		}
+		std::lock_guard<std::mutex> lock(startupMutex);
+		if(cached[adType][index]) {
+			return;
+		}
+		cached[adType][index] = true;
+		FirstCache& first = firstCaches[firstCacheCount++];
+		first.adType = adType;
+		first.location = index;
+		first.time = time;
+	}
+	
+	std::string getStartupReport()
+	{
+		std::lock_guard<std::mutex> lock(startupMutex);
+		double origin = milestones[STARTUP_NDLL_LOADED];
+		std::string report;
+		for(int i = 0; i < STARTUP_MILESTONE_COUNT; i++) {
+			if(reached[i]) {
+				appendf(report, "%s\t%.6f\n", milestoneNames[i], milestones[i] - origin);
+			}
+		}
+		for(int i = 0; i < firstCacheCount; i++) {
+			const FirstCache& first = firstCaches[i];
+			appendf(report, "first_cache\t%s\t%s\t%.6f\n", adTypeNames[first.adType], getLocationName(first.location), first.time - origin);
+		}
+		return report;
+	}
+}
\ No newline at end of file
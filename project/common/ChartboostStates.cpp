@@ -0,0 +1,127 @@
+#include <atomic>
+#include <cmath>
+#include <mutex>
+
+#include "ChartboostLocations.h"
+#include "ChartboostStates.h"
+#include "SamcodesChartboost.h"
+
+namespace samcodeschartboost
+{
+	namespace
+	{
+		#define STATE_BIT(state) (1 << (state))
+		
+		// The states each state may move to, as bit masks. Showing an uncached location is legal since the SDK loads it first.
+		// The SDK caches on its own (rewarded videos again after a close, with no shouldRequest callback) and can answer a request
+		// after reporting it failed, so any state but Showing may move to Cached. Cache requests made while an ad is on screen
+		// move a Displayed location to Requesting
+		const int legalTransitions[LOCATION_STATE_COUNT] = {
+			STATE_BIT(LOCATION_REQUESTING) | STATE_BIT(LOCATION_CACHED) | STATE_BIT(LOCATION_SHOWING), // Idle
+			STATE_BIT(LOCATION_CACHED) | STATE_BIT(LOCATION_FAILED) | STATE_BIT(LOCATION_SHOWING), // Requesting
+			STATE_BIT(LOCATION_REQUESTING) | STATE_BIT(LOCATION_SHOWING) | STATE_BIT(LOCATION_FAILED), // Cached
+			STATE_BIT(LOCATION_DISPLAYED) | STATE_BIT(LOCATION_FAILED) | STATE_BIT(LOCATION_CLOSED), // Showing
+			STATE_BIT(LOCATION_REQUESTING) | STATE_BIT(LOCATION_CACHED) | STATE_BIT(LOCATION_CLOSED), // Displayed
+			STATE_BIT(LOCATION_REQUESTING) | STATE_BIT(LOCATION_CACHED) | STATE_BIT(LOCATION_SHOWING), // Closed
+			STATE_BIT(LOCATION_REQUESTING) | STATE_BIT(LOCATION_CACHED) | STATE_BIT(LOCATION_SHOWING) // Failed
+		};
+		
+		#undef STATE_BIT
+		
+		// Struct of arrays, indexed by [adType][locationIndex]. Transitions are serialized by the mutex, everything read by
+		// the getters is atomic so it can be read from any thread without taking it
+		std::atomic<unsigned char> states[AD_TYPE_COUNT][MAX_LOCATIONS];
+		double enteredAt[AD_TYPE_COUNT][MAX_LOCATIONS];
+		std::atomic<float> dwellTimes[AD_TYPE_COUNT][LOCATION_STATE_COUNT][MAX_LOCATIONS];
+		
+		std::atomic<int> dwellHistograms[AD_TYPE_COUNT][LOCATION_STATE_COUNT][DWELL_BUCKET_COUNT];
+		std::atomic<int> illegalTransitions(0);
+		std::mutex statsMutex;
+		
+		int getDwellBucket(double seconds)
+		{
+			double milliseconds = seconds * 1000.0;
+			if(milliseconds < 1.0) {
+				return 0;
+			}
+			int bucket = (int)std::log2(milliseconds) + 1;
+			return bucket < DWELL_BUCKET_COUNT ? bucket : DWELL_BUCKET_COUNT - 1;
+		}
+	}
+	
+	bool advanceLocationState(int adType, const char* location, int state, double now)
+	{
+		int index = internLocation(location);
+		if(adType < 0 || adType >= AD_TYPE_COUNT || index < 0 || state < 0 || state >= LOCATION_STATE_COUNT) {
+			return false;
+		}
+		
+		std::lock_guard<std::mutex> lock(statsMutex);
+		int previous = states[adType][index].load(std::memory_order_relaxed);
+		if(previous == state) {
+			return true;
+		}
+		
+		// The first callback for a location has nothing to time, its idle time is from before the bridge knew about it
+		bool known = enteredAt[adType][index] > 0.0;
+		if(known) {
+			double dwell = now - enteredAt[adType][index];
+			std::atomic<float>& dwellTime = dwellTimes[adType][previous][index];
+			dwellTime.store(dwellTime.load(std::memory_order_relaxed) + (float)dwell, std::memory_order_relaxed);
+			dwellHistograms[adType][previous][getDwellBucket(dwell)].fetch_add(1, std::memory_order_relaxed);
+		}
+		enteredAt[adType][index] = now;
+		states[adType][index].store((unsigned char)state, std::memory_order_relaxed);
+		
+		bool legal = (legalTransitions[previous] & (1 << state)) != 0;
+		if(!legal) {
+			illegalTransitions++;
+		}
+		return legal;
+	}
+	
+	int getLocationState(int adType, int locationIndex)
+	{
+		if(adType < 0 || adType >= AD_TYPE_COUNT || locationIndex < 0 || locationIndex >= MAX_LOCATIONS) {
+			return LOCATION_IDLE;
+		}
+		return states[adType][locationIndex].load(std::memory_order_relaxed);
+	}
+	
+	double getLocationDwellTime(int adType, int locationIndex, int state)
+	{
+		if(adType < 0 || adType >= AD_TYPE_COUNT || locationIndex < 0 || locationIndex >= MAX_LOCATIONS || state < 0 || state >= LOCATION_STATE_COUNT) {
+			return 0.0;
+		}
+		return dwellTimes[adType][state][locationIndex].load(std::memory_order_relaxed);
+	}
+	
+	int getDwellHistogramCount(int adType, int state, int bucket)
+	{
+		if(adType < 0 || adType >= AD_TYPE_COUNT || state < 0 || state >= LOCATION_STATE_COUNT || bucket < 0 || bucket >= DWELL_BUCKET_COUNT) {
+			return 0;
+		}
+		return dwellHistograms[adType][state][bucket].load(std::memory_order_relaxed);
+	}
+	
+	int getIllegalTransitionCount()
+	{
+		return illegalTransitions.load();
+	}
+	
+	void resetLocationStats()
+	{
+		std::lock_guard<std::mutex> lock(statsMutex);
+		for(int type = 0; type < AD_TYPE_COUNT; type++) {
+			for(int state = 0; state < LOCATION_STATE_COUNT; state++) {
+				for(int i = 0; i < MAX_LOCATIONS; i++) {
+					dwellTimes[type][state][i].store(0.0f, std::memory_order_relaxed);
+				}
+				for(int bucket = 0; bucket < DWELL_BUCKET_COUNT; bucket++) {
+					dwellHistograms[type][state][bucket].store(0, std::memory_order_relaxed);
+				}
+			}
+		}
+		illegalTransitions.store(0);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#include <stdarg.h>
+#include <stdio.h>
+
+#include "ChartboostText.h"
+
+namespace samcodeschartboost
+{
+	void appendf(std::string& out, const char* format, ...)
+	{
+		va_list args;
+		va_start(args, format);
+		va_list measure;
+		va_copy(measure, args);
+		int length = vsnprintf(NULL, 0, format, measure);
+		va_end(measure);
+		if(length > 0) {
+			size_t offset = out.size();
+			out.resize(offset + length + 1);
+			vsnprintf(&out[offset], length + 1, format, args);
+			out.resize(offset + length);
+		}
+		va_end(args);
+	}
+}
\ No newline at end of file
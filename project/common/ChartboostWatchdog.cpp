@@ -0,0 +1,209 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#if defined(__APPLE__)
+#include <pthread.h>
+#endif
+
+#include "ChartboostClock.h"
+#include "ChartboostFlightRecorder.h"
+#include "ChartboostLocations.h"
+#include "ChartboostWatchdog.h"
+
+namespace samcodeschartboost
+{
+	namespace
+	{
+		// Calls in progress, normally just the one on the main thread. Calls beyond this many at once are timed but not watched
+		const int MAX_ACTIVE_CALLS = 8;
+		
+		// A slot is claimed by a call before its fields are written, and only published to the watchdog through inUse once they are.
+		// The generation changes with every claim, so the watchdog can tell if the slot was reused while it read the fields
+		struct ActiveCall
+		{
+			std::atomic<bool> claimed;
+			std::atomic<bool> inUse;
+			std::atomic<unsigned int> generation;
+			std::atomic<bool> hangReported;
+			std::atomic<double> start;
+			std::atomic<const char*> call;
+			std::atomic<int> location;
+		};
+		
+		ActiveCall activeCalls[MAX_ACTIVE_CALLS];
+		std::atomic<double> stallThreshold(0.016);
+		
+		std::mutex statsMutex;
+		StallStats stats;
+		StallRecord recentStalls[MAX_RECENT_STALLS];
+		unsigned int recentStallCount = 0;
+		
+		std::mutex watchdogMutex;
+		std::condition_variable watchdogWake;
+		int watchdogGeneration = 0; // Bumped on every start and stop, so a thread from an earlier start stops even if another was started since
+		bool watchdogRunning = false;
+		double hangThreshold = 1.0;
+		
+		// Only main thread calls can stall frames. The SDK is only called from the main thread off Apple platforms
+		bool isMainThread()
+		{
+#if defined(__APPLE__)
+			return pthread_main_np() != 0;
+#else
+			return true;
+#endif
+		}
+		
+		void recordStall(const char* call, int location, double duration, bool hang)
+		{
+			{
+				std::lock_guard<std::mutex> lock(statsMutex);
+				if(hang) {
+					stats.hangs++;
+				} else {
+					stats.stalls++;
+				}
+				StallRecord& record = recentStalls[recentStallCount % MAX_RECENT_STALLS];
+				record.call = call;
+				record.location = location;
+				record.duration = duration;
+				record.hang = hang;
+				recentStallCount++;
+			}
+			recordFlightEvent(hang ? FLIGHT_HANG : FLIGHT_STALL, call, location, duration);
+		}
+		
+		void runWatchdog(int generation)
+		{
+			std::unique_lock<std::mutex> lock(watchdogMutex);
+			while(watchdogRunning && watchdogGeneration == generation) {
+				double threshold = hangThreshold;
+				watchdogWake.wait_for(lock, std::chrono::duration<double>(threshold / 4.0));
+				if(!watchdogRunning || watchdogGeneration != generation) {
+					break;
+				}
+				
+				double now = getMonotonicTime();
+				for(int i = 0; i < MAX_ACTIVE_CALLS; i++) {
+					ActiveCall& active = activeCalls[i];
+					unsigned int generation = active.generation.load(std::memory_order_acquire);
+					if(!active.inUse.load(std::memory_order_acquire) || active.hangReported.load()) {
+						continue;
+					}
+					double running = now - active.start.load();
+					const char* call = active.call.load();
+					int location = active.location.load();
+					if(active.generation.load(std::memory_order_acquire) != generation) {
+						continue;
+					}
+					if(running >= threshold && !active.hangReported.exchange(true)) {
+						recordStall(call, location, running, true);
+					}
+				}
+			}
+		}
+	}
+	
+	ScopedSdkCall::ScopedSdkCall(const char* call, const char* location) : slot(-1), start(getMonotonicTime()), timed(isMainThread())
+	{
+		if(!timed) {
+			return;
+		}
+		for(int i = 0; i < MAX_ACTIVE_CALLS; i++) {
+			bool expected = false;
+			if(activeCalls[i].claimed.compare_exchange_strong(expected, true)) {
+				slot = i;
+				break;
+			}
+		}
+		if(slot >= 0) {
+			ActiveCall& active = activeCalls[slot];
+			active.generation.fetch_add(1, std::memory_order_acq_rel);
+			active.hangReported.store(false);
+			active.call.store(call);
+			active.location.store(location != NULL && location[0] != '\0' ? internLocation(location) : -1);
+			active.start.store(start);
+			active.inUse.store(true, std::memory_order_release);
+		}
+	}
+	
+	ScopedSdkCall::~ScopedSdkCall()
+	{
+		if(!timed) {
+			return;
+		}
+		double duration = getMonotonicTime() - start;
+		const char* call = "";
+		int location = -1;
+		if(slot >= 0) {
+			call = activeCalls[slot].call.load();
+			location = activeCalls[slot].location.load();
+			activeCalls[slot].inUse.store(false);
+			activeCalls[slot].claimed.store(false, std::memory_order_release);
+		}
+		
+		{
+			std::lock_guard<std::mutex> lock(statsMutex);
+			stats.calls++;
+			if(duration > stats.maxDuration) {
+				stats.maxDuration = duration;
+			}
+		}
+		if(duration >= stallThreshold.load()) {
+			recordStall(call, location, duration, false);
+		}
+	}
+	
+	void setStallThreshold(double seconds)
+	{
+		stallThreshold.store(seconds);
+	}
+	
+	void startStallWatchdog(double threshold)
+	{
+		std::lock_guard<std::mutex> lock(watchdogMutex);
+		hangThreshold = threshold > 0.0 ? threshold : 1.0;
+		if(watchdogRunning) {
+			watchdogWake.notify_all();
+			return;
+		}
+		watchdogGeneration++;
+		watchdogRunning = true;
+		std::thread(runWatchdog, watchdogGeneration).detach();
+	}
+	
+	void stopStallWatchdog()
+	{
+		std::lock_guard<std::mutex> lock(watchdogMutex);
+		watchdogGeneration++;
+		watchdogRunning = false;
+		watchdogWake.notify_all();
+	}
+	
+	StallStats getStallStats()
+	{
+		std::lock_guard<std::mutex> lock(statsMutex);
+		return stats;
+	}
+	
+	int getRecentStalls(StallRecord* out)
+	{
+		std::lock_guard<std::mutex> lock(statsMutex);
+		unsigned int first = recentStallCount > MAX_RECENT_STALLS ? recentStallCount - MAX_RECENT_STALLS : 0;
+		int count = 0;
+		for(unsigned int i = first; i < recentStallCount; i++) {
+			out[count++] = recentStalls[i % MAX_RECENT_STALLS];
+		}
+		return count;
+	}
+	
+	void resetStallStats()
+	{
+		std::lock_guard<std::mutex> lock(statsMutex);
+		stats = StallStats();
+		recentStallCount = 0;
+	}
+}
\ No newline at end of file
@@ -6,25 +6,88 @@
 #define NEKO_COMPATIBLE
 #endif
 
+#include <string.h>
+
 #include <hx/CFFI.h>
 #include <hx/CFFIPrime.h>
 
+#include "ChartboostAllocationAudit.h"
+#include "ChartboostAnalytics.h"
+#include "ChartboostBindingProfiler.h"
+#include "ChartboostClock.h"
+#include "ChartboostConsent.h"
+#include "ChartboostErrors.h"
+#include "ChartboostFlightRecorder.h"
+#include "ChartboostLocations.h"
+#include "ChartboostMemory.h"
+#include "ChartboostMetrics.h"
+#include "ChartboostPredictor.h"
+#include "ChartboostPurchases.h"
+#include "ChartboostScheduler.h"
+#include "ChartboostSelector.h"
+#include "ChartboostStartup.h"
+#include "ChartboostStates.h"
+#include "ChartboostWatchdog.h"
 #include "SamcodesChartboost.h"
 
 using namespace samcodeschartboost;
 
+// Build with SAMCODESCHARTBOOST_PROFILE_BINDINGS defined to count and time every binding, and the string bytes it marshals,
+// and with SAMCODESCHARTBOOST_AUDIT_ALLOCATIONS defined to count the allocations each binding makes. Without them these expand to nothing
+#if defined(SAMCODESCHARTBOOST_PROFILE_BINDINGS) || defined(SAMCODESCHARTBOOST_AUDIT_ALLOCATIONS)
+#define SCB_BINDING_INDEX() static const int bindingIndex = registerBinding(__func__)
+#else
+#define SCB_BINDING_INDEX()
+#endif
+
+#ifdef SAMCODESCHARTBOOST_PROFILE_BINDINGS
+#define SCB_BINDING_TIMER() ScopedBindingTimer bindingTimer(bindingIndex)
+#define SCB_PROFILE_STRING(s) bindingTimer.addStringBytes((s).length)
+#else
+#define SCB_BINDING_TIMER()
+#define SCB_PROFILE_STRING(s)
+#endif
+
+#define SCB_PROFILE_BINDING() SCB_BINDING_INDEX(); SCB_BINDING_TIMER(); SCB_AUDIT_BINDING(bindingIndex)
+
+#ifdef SAMCODESCHARTBOOST_PROFILE_BINDINGS
+#define SCB_BINDING_TIMER_ADDRESS &bindingTimer
+#else
+#define SCB_BINDING_TIMER_ADDRESS NULL
+#endif
+
+#if defined(SAMCODESCHARTBOOST_PROFILE_BINDINGS) || defined(SAMCODESCHARTBOOST_AUDIT_ALLOCATIONS)
+#define SCB_PROFILE_STRING_RESULT(s) profileStringResult(SCB_BINDING_TIMER_ADDRESS, s)
+
+// Strings returned to Haxe are copied into a GC string
+static HxString profileStringResult(ScopedBindingTimer* timer, HxString s)
+{
+	if(timer != NULL) {
+		timer->addStringBytes(s.length);
+	}
+	SCB_AUDIT_ALLOCATION(ALLOCATION_GC, s.length + 1);
+	return s;
+}
+#else
+#define SCB_PROFILE_STRING_RESULT(s) (s)
+#endif
+
 #ifdef IPHONE
 
 AutoGCRoot* chartboostEventHandle = 0;
 
 void samcodeschartboost_init_chartboost(HxString appId, HxString appSignature)
 {
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(appId);
+	SCB_PROFILE_STRING(appSignature);
 	initChartboost(appId.c_str(), appSignature.c_str());
 }
 DEFINE_PRIME2v(samcodeschartboost_init_chartboost);
 
 void samcodeschartboost_set_listener(value onEvent)
 {
+	SCB_PROFILE_BINDING();
 	if(chartboostEventHandle == 0) {
 		chartboostEventHandle = new AutoGCRoot(onEvent);
 	} else {
@@ -35,118 +98,794 @@ DEFINE_PRIME1v(samcodeschartboost_set_listener);
 
 void samcodeschartboost_show_interstitial(HxString location)
 {
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(location);
 	showInterstitial(location.c_str());
 }
 DEFINE_PRIME1v(samcodeschartboost_show_interstitial);
 
 void samcodeschartboost_cache_interstitial(HxString location)
 {
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(location);
 	cacheInterstitial(location.c_str());
 }
 DEFINE_PRIME1v(samcodeschartboost_cache_interstitial);
 
 bool samcodeschartboost_has_interstitial(HxString location)
 {
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(location);
 	return hasInterstitial(location.c_str());
 }
 DEFINE_PRIME1(samcodeschartboost_has_interstitial);
 
 void samcodeschartboost_show_rewarded_video(HxString location)
 {
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(location);
 	showRewardedVideo(location.c_str());
 }
 DEFINE_PRIME1v(samcodeschartboost_show_rewarded_video);
 
 void samcodeschartboost_cache_rewarded_video(HxString location)
 {
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(location);
 	cacheRewardedVideo(location.c_str());
 }
 DEFINE_PRIME1v(samcodeschartboost_cache_rewarded_video);
 
 bool samcodeschartboost_has_rewarded_video(HxString location)
 {
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(location);
 	return hasRewardedVideo(location.c_str());
 }
 DEFINE_PRIME1(samcodeschartboost_has_rewarded_video);
 
 bool samcodeschartboost_is_any_view_visible()
 {
+	SCB_PROFILE_BINDING();
 	return isAnyViewVisible();
 }
 DEFINE_PRIME0(samcodeschartboost_is_any_view_visible);
 
 void samcodeschartboost_set_custom_id(HxString id)
 {
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(id);
 	setCustomId(id.c_str());
 }
 DEFINE_PRIME1v(samcodeschartboost_set_custom_id);
 
 HxString samcodeschartboost_get_custom_id()
 {
-	return HxString(getCustomId());
+	SCB_PROFILE_BINDING();
+	return SCB_PROFILE_STRING_RESULT(HxString(getCustomId()));
 }
 DEFINE_PRIME0(samcodeschartboost_get_custom_id);
 
 void samcodeschartboost_set_should_request_interstitials_in_first_session(bool shouldRequest)
 {
+	SCB_PROFILE_BINDING();
 	setShouldRequestInterstitialsInFirstSession(shouldRequest);
 }
 DEFINE_PRIME1v(samcodeschartboost_set_should_request_interstitials_in_first_session);
 
 bool samcodeschartboost_get_auto_cache_ads()
 {
+	SCB_PROFILE_BINDING();
 	return getAutoCacheAds();
 }
 DEFINE_PRIME0(samcodeschartboost_get_auto_cache_ads);
 
 void samcodeschartboost_set_auto_cache_ads(bool autoCache)
 {
+	SCB_PROFILE_BINDING();
 	setAutoCacheAds(autoCache);
 }
 DEFINE_PRIME1v(samcodeschartboost_set_auto_cache_ads);
 
 void samcodeschartboost_set_should_prefetch_video_content(bool shouldPrefetch)
 {
+	SCB_PROFILE_BINDING();
 	setShouldPrefetchVideoContent(shouldPrefetch);
 }
 DEFINE_PRIME1v(samcodeschartboost_set_should_prefetch_video_content);
 
 HxString samcodeschartboost_get_sdk_version()
 {
-	return HxString(getSDKVersion());
+	SCB_PROFILE_BINDING();
+	return SCB_PROFILE_STRING_RESULT(HxString(getSDKVersion()));
 }
 DEFINE_PRIME0(samcodeschartboost_get_sdk_version);
 
 void samcodeschartboost_set_status_bar_behavior(bool shouldHide)
 {
+	SCB_PROFILE_BINDING();
 	setStatusBarBehavior(shouldHide);
 }
 DEFINE_PRIME1v(samcodeschartboost_set_status_bar_behavior);
 
 void samcodeschartboost_set_muted(bool mute)
 {
+	SCB_PROFILE_BINDING();
 	setMuted(mute);
 }
 DEFINE_PRIME1v(samcodeschartboost_set_muted);
 
 void samcodeschartboost_restrict_data_collection(bool shouldRestrict)
 {
-	restrictDataCollection(shouldRestrict);
+	SCB_PROFILE_BINDING();
+	changeConsent(shouldRestrict ? CONSENT_NO_BEHAVIORAL : CONSENT_YES_BEHAVIORAL);
 }
 DEFINE_PRIME1v(samcodeschartboost_restrict_data_collection);
 
 int samcodeschartboost_get_pi_data_use_consent()
 {
-	return getPIDataUseConsent();
+	SCB_PROFILE_BINDING();
+	return getConsent();
 }
 DEFINE_PRIME0(samcodeschartboost_get_pi_data_use_consent);
 
 void samcodeschartboost_set_pi_data_use_consent(int consent)
 {
-	setPIDataUseConsent(consent);
+	SCB_PROFILE_BINDING();
+	changeConsent(consent);
 }
 DEFINE_PRIME1v(samcodeschartboost_set_pi_data_use_consent);
 
+void samcodeschartboost_set_consent_change_policy(int policy)
+{
+	SCB_PROFILE_BINDING();
+	setConsentChangePolicy(policy);
+}
+DEFINE_PRIME1v(samcodeschartboost_set_consent_change_policy);
+
+int samcodeschartboost_get_consent_change_policy()
+{
+	SCB_PROFILE_BINDING();
+	return getConsentChangePolicy();
+}
+DEFINE_PRIME0(samcodeschartboost_get_consent_change_policy);
+
+bool samcodeschartboost_is_consent_stale(int adType, int locationIndex)
+{
+	SCB_PROFILE_BINDING();
+	return isConsentStale(adType, locationIndex);
+}
+DEFINE_PRIME2(samcodeschartboost_is_consent_stale);
+
+int samcodeschartboost_get_consent_change_count()
+{
+	SCB_PROFILE_BINDING();
+	return getConsentChangeCount();
+}
+DEFINE_PRIME0(samcodeschartboost_get_consent_change_count);
+
+int samcodeschartboost_acquire_banner(HxString location, int size)
+{
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(location);
+	return acquireBanner(location.c_str(), size);
+}
+DEFINE_PRIME2(samcodeschartboost_acquire_banner);
+
+void samcodeschartboost_release_banner(int handle)
+{
+	SCB_PROFILE_BINDING();
+	releaseBanner(handle);
+}
+DEFINE_PRIME1v(samcodeschartboost_release_banner);
+
+void samcodeschartboost_show_banner(int handle)
+{
+	SCB_PROFILE_BINDING();
+	showBanner(handle);
+}
+DEFINE_PRIME1v(samcodeschartboost_show_banner);
+
+void samcodeschartboost_hide_banner(int handle)
+{
+	SCB_PROFILE_BINDING();
+	hideBanner(handle);
+}
+DEFINE_PRIME1v(samcodeschartboost_hide_banner);
+
+void samcodeschartboost_set_banner_position(int handle, double x, double y)
+{
+	SCB_PROFILE_BINDING();
+	setBannerPosition(handle, x, y);
+}
+DEFINE_PRIME3v(samcodeschartboost_set_banner_position);
+
+void samcodeschartboost_set_banner_refresh_interval(int handle, double seconds)
+{
+	SCB_PROFILE_BINDING();
+	setBannerRefreshInterval(handle, seconds);
+}
+DEFINE_PRIME2v(samcodeschartboost_set_banner_refresh_interval);
+
+bool samcodeschartboost_is_banner_cached(int handle)
+{
+	SCB_PROFILE_BINDING();
+	return isBannerCached(handle);
+}
+DEFINE_PRIME1(samcodeschartboost_is_banner_cached);
+
+void samcodeschartboost_update_banners(double dt, bool frameBudgetTight)
+{
+	SCB_PROFILE_BINDING();
+	updateBanners(dt, frameBudgetTight);
+}
+DEFINE_PRIME2v(samcodeschartboost_update_banners);
+
+void samcodeschartboost_drain_banner_pool()
+{
+	SCB_PROFILE_BINDING();
+	drainBannerPool();
+}
+DEFINE_PRIME0v(samcodeschartboost_drain_banner_pool);
+
+int samcodeschartboost_create_ad(int type, HxString location)
+{
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(location);
+	return createAd(type, location.c_str());
+}
+DEFINE_PRIME2(samcodeschartboost_create_ad);
+
+void samcodeschartboost_release_ad(int handle)
+{
+	SCB_PROFILE_BINDING();
+	releaseAd(handle);
+}
+DEFINE_PRIME1v(samcodeschartboost_release_ad);
+
+void samcodeschartboost_cache_ad(int handle)
+{
+	SCB_PROFILE_BINDING();
+	cacheAd(handle);
+}
+DEFINE_PRIME1v(samcodeschartboost_cache_ad);
+
+void samcodeschartboost_show_ad(int handle)
+{
+	SCB_PROFILE_BINDING();
+	showAd(handle);
+}
+DEFINE_PRIME1v(samcodeschartboost_show_ad);
+
+bool samcodeschartboost_is_ad_cached(int handle)
+{
+	SCB_PROFILE_BINDING();
+	return isAdCached(handle);
+}
+DEFINE_PRIME1(samcodeschartboost_is_ad_cached);
+
+int samcodeschartboost_get_error_count(int code)
+{
+	SCB_PROFILE_BINDING();
+	return getErrorCount(code);
+}
+DEFINE_PRIME1(samcodeschartboost_get_error_count);
+
+void samcodeschartboost_reset_error_counts()
+{
+	SCB_PROFILE_BINDING();
+	resetErrorCounts();
+}
+DEFINE_PRIME0v(samcodeschartboost_reset_error_counts);
+
+void samcodeschartboost_track_level_info(HxString label, int levelType, int mainLevel, int subLevel, HxString description)
+{
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(label);
+	SCB_PROFILE_STRING(description);
+	trackLevelInfo(label.c_str(), levelType, mainLevel, subLevel, description.c_str());
+}
+DEFINE_PRIME5v(samcodeschartboost_track_level_info);
+
+void samcodeschartboost_flush_level_info()
+{
+	SCB_PROFILE_BINDING();
+	requestLevelInfoFlush();
+}
+DEFINE_PRIME0v(samcodeschartboost_flush_level_info);
+
+void samcodeschartboost_set_level_info_flush_interval(double seconds)
+{
+	SCB_PROFILE_BINDING();
+	setLevelInfoFlushInterval(seconds);
+}
+DEFINE_PRIME1v(samcodeschartboost_set_level_info_flush_interval);
+
+void samcodeschartboost_track_in_app_purchase(value receipt, HxString title, HxString description, HxString price, HxString currency, HxString productId)
+{
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(title);
+	SCB_PROFILE_STRING(description);
+	SCB_PROFILE_STRING(price);
+	SCB_PROFILE_STRING(currency);
+	SCB_PROFILE_STRING(productId);
+	// The receipt is a haxe.io.Bytes, copied straight into the queue file. Base64 encoding happens later on the queue's thread
+	buffer receiptBuffer = val_to_buffer(val_field(receipt, val_id("b")));
+	int receiptLength = val_int(val_field(receipt, val_id("length")));
+	queuePurchase(reinterpret_cast<const unsigned char*>(buffer_data(receiptBuffer)), receiptLength, false, title.c_str(), description.c_str(), price.c_str(), currency.c_str(), productId.c_str());
+}
+DEFINE_PRIME6v(samcodeschartboost_track_in_app_purchase);
+
+void samcodeschartboost_track_in_app_purchase_with_string(HxString receiptBase64, HxString title, HxString description, HxString price, HxString currency, HxString productId)
+{
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(receiptBase64);
+	SCB_PROFILE_STRING(title);
+	SCB_PROFILE_STRING(description);
+	SCB_PROFILE_STRING(price);
+	SCB_PROFILE_STRING(currency);
+	SCB_PROFILE_STRING(productId);
+	queuePurchase(reinterpret_cast<const unsigned char*>(receiptBase64.c_str()), receiptBase64.length, true, title.c_str(), description.c_str(), price.c_str(), currency.c_str(), productId.c_str());
+}
+DEFINE_PRIME6v(samcodeschartboost_track_in_app_purchase_with_string);
+
+int samcodeschartboost_get_queued_purchase_count()
+{
+	SCB_PROFILE_BINDING();
+	return getQueuedPurchaseCount();
+}
+DEFINE_PRIME0(samcodeschartboost_get_queued_purchase_count);
+
+void samcodeschartboost_cache_in_play(HxString location)
+{
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(location);
+	cacheInPlay(location.c_str());
+}
+DEFINE_PRIME1v(samcodeschartboost_cache_in_play);
+
+bool samcodeschartboost_has_in_play(HxString location)
+{
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(location);
+	return hasInPlay(location.c_str());
+}
+DEFINE_PRIME1(samcodeschartboost_has_in_play);
+
+int samcodeschartboost_get_in_play(HxString location)
+{
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(location);
+	return getInPlay(location.c_str());
+}
+DEFINE_PRIME1(samcodeschartboost_get_in_play);
+
+void samcodeschartboost_release_in_play(int handle)
+{
+	SCB_PROFILE_BINDING();
+	releaseInPlay(handle);
+}
+DEFINE_PRIME1v(samcodeschartboost_release_in_play);
+
+HxString samcodeschartboost_get_in_play_app_name(int handle)
+{
+	SCB_PROFILE_BINDING();
+	return SCB_PROFILE_STRING_RESULT(HxString(getInPlayAppName(handle)));
+}
+DEFINE_PRIME1(samcodeschartboost_get_in_play_app_name);
+
+int samcodeschartboost_get_in_play_icon_length(int handle)
+{
+	SCB_PROFILE_BINDING();
+	return getInPlayIconLength(handle);
+}
+DEFINE_PRIME1(samcodeschartboost_get_in_play_icon_length);
+
+void samcodeschartboost_decode_in_play_icon(int handle)
+{
+	SCB_PROFILE_BINDING();
+	decodeInPlayIcon(handle);
+}
+DEFINE_PRIME1v(samcodeschartboost_decode_in_play_icon);
+
+bool samcodeschartboost_is_in_play_icon_decoded(int handle)
+{
+	SCB_PROFILE_BINDING();
+	return isInPlayIconDecoded(handle);
+}
+DEFINE_PRIME1(samcodeschartboost_is_in_play_icon_decoded);
+
+int samcodeschartboost_get_in_play_icon_width(int handle)
+{
+	SCB_PROFILE_BINDING();
+	return getInPlayIconWidth(handle);
+}
+DEFINE_PRIME1(samcodeschartboost_get_in_play_icon_width);
+
+int samcodeschartboost_get_in_play_icon_height(int handle)
+{
+	SCB_PROFILE_BINDING();
+	return getInPlayIconHeight(handle);
+}
+DEFINE_PRIME1(samcodeschartboost_get_in_play_icon_height);
+
+void samcodeschartboost_show_in_play(int handle)
+{
+	SCB_PROFILE_BINDING();
+	showInPlay(handle);
+}
+DEFINE_PRIME1v(samcodeschartboost_show_in_play);
+
+void samcodeschartboost_click_in_play(int handle)
+{
+	SCB_PROFILE_BINDING();
+	clickInPlay(handle);
+}
+DEFINE_PRIME1v(samcodeschartboost_click_in_play);
+
+void samcodeschartboost_clear_in_play_cache(int handle)
+{
+	SCB_PROFILE_BINDING();
+	clearInPlayCache(handle);
+}
+DEFINE_PRIME1v(samcodeschartboost_clear_in_play_cache);
+
+void samcodeschartboost_request_cache(int adType, HxString location, bool urgent)
+{
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(location);
+	getScheduler().request(adType, location.c_str(), urgent, getMonotonicTime());
+}
+DEFINE_PRIME3v(samcodeschartboost_request_cache);
+
+void samcodeschartboost_begin_idle_window()
+{
+	SCB_PROFILE_BINDING();
+	getScheduler().beginIdleWindow(getMonotonicTime());
+}
+DEFINE_PRIME0v(samcodeschartboost_begin_idle_window);
+
+void samcodeschartboost_end_idle_window()
+{
+	SCB_PROFILE_BINDING();
+	getScheduler().endIdleWindow(getMonotonicTime());
+}
+DEFINE_PRIME0v(samcodeschartboost_end_idle_window);
+
+void samcodeschartboost_update_scheduler()
+{
+	SCB_PROFILE_BINDING();
+	double now = getMonotonicTime();
+	getPredictor().update(now);
+	getScheduler().update(now);
+}
+DEFINE_PRIME0v(samcodeschartboost_update_scheduler);
+
+void samcodeschartboost_set_scheduler_policy(int maxInFlight, int maxRetries, double retryBackoff, double requestTimeout, bool deferOutsideIdle)
+{
+	SCB_PROFILE_BINDING();
+	SchedulerPolicy policy;
+	policy.maxInFlight = maxInFlight;
+	policy.maxRetries = maxRetries;
+	policy.retryBackoff = retryBackoff;
+	policy.requestTimeout = requestTimeout;
+	policy.deferOutsideIdle = deferOutsideIdle;
+	getScheduler().setPolicy(policy);
+}
+DEFINE_PRIME5v(samcodeschartboost_set_scheduler_policy);
+
+int samcodeschartboost_get_scheduler_pending_count()
+{
+	SCB_PROFILE_BINDING();
+	return getScheduler().getPendingCount();
+}
+DEFINE_PRIME0(samcodeschartboost_get_scheduler_pending_count);
+
+int samcodeschartboost_get_scheduler_in_flight_count()
+{
+	SCB_PROFILE_BINDING();
+	return getScheduler().getInFlightCount();
+}
+DEFINE_PRIME0(samcodeschartboost_get_scheduler_in_flight_count);
+
+void samcodeschartboost_watch_placement(int adType, HxString location, int stepsPerShow, int maxShows)
+{
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(location);
+	getPredictor().watchPlacement(adType, location.c_str(), stepsPerShow, maxShows, getMonotonicTime());
+}
+DEFINE_PRIME4v(samcodeschartboost_watch_placement);
+
+void samcodeschartboost_unwatch_placement(int adType, HxString location)
+{
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(location);
+	getPredictor().unwatchPlacement(adType, location.c_str());
+}
+DEFINE_PRIME2v(samcodeschartboost_unwatch_placement);
+
+void samcodeschartboost_report_progress_step(int adType, HxString location)
+{
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(location);
+	getPredictor().reportStep(adType, location.c_str(), getMonotonicTime());
+}
+DEFINE_PRIME2v(samcodeschartboost_report_progress_step);
+
+double samcodeschartboost_get_time_to_show(int adType, HxString location)
+{
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(location);
+	return getPredictor().getTimeToShow(adType, location.c_str(), getMonotonicTime());
+}
+DEFINE_PRIME2(samcodeschartboost_get_time_to_show);
+
+void samcodeschartboost_set_predictor_policy(double safetyFactor, double defaultCacheTime, double smoothing)
+{
+	SCB_PROFILE_BINDING();
+	PredictorPolicy policy;
+	policy.safetyFactor = safetyFactor;
+	policy.defaultCacheTime = defaultCacheTime;
+	policy.smoothing = smoothing;
+	getPredictor().setPolicy(policy);
+}
+DEFINE_PRIME3v(samcodeschartboost_set_predictor_policy);
+
+void samcodeschartboost_add_selector_candidate(HxString group, int adType, HxString location)
+{
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(group);
+	SCB_PROFILE_STRING(location);
+	getSelector().addCandidate(group.c_str(), adType, location.c_str());
+}
+DEFINE_PRIME3v(samcodeschartboost_add_selector_candidate);
+
+void samcodeschartboost_clear_selector_group(HxString group)
+{
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(group);
+	getSelector().clearGroup(group.c_str());
+}
+DEFINE_PRIME1v(samcodeschartboost_clear_selector_group);
+
+HxString samcodeschartboost_select_placement(HxString group)
+{
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(group);
+	static std::string selected;
+	selected = getSelector().select(group.c_str());
+	return SCB_PROFILE_STRING_RESULT(HxString(selected.c_str()));
+}
+DEFINE_PRIME1(samcodeschartboost_select_placement);
+
+void samcodeschartboost_set_selector_params(double latencyScale, double exploration)
+{
+	SCB_PROFILE_BINDING();
+	getSelector().setLatencyScale(latencyScale);
+	getSelector().setExploration(exploration);
+}
+DEFINE_PRIME2v(samcodeschartboost_set_selector_params);
+
+int samcodeschartboost_get_location_index(HxString location)
+{
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(location);
+	return internLocation(location.c_str());
+}
+DEFINE_PRIME1(samcodeschartboost_get_location_index);
+
+int samcodeschartboost_get_location_state(int adType, int locationIndex)
+{
+	SCB_PROFILE_BINDING();
+	return getLocationState(adType, locationIndex);
+}
+DEFINE_PRIME2(samcodeschartboost_get_location_state);
+
+double samcodeschartboost_get_location_dwell_time(int adType, int locationIndex, int state)
+{
+	SCB_PROFILE_BINDING();
+	return getLocationDwellTime(adType, locationIndex, state);
+}
+DEFINE_PRIME3(samcodeschartboost_get_location_dwell_time);
+
+int samcodeschartboost_get_dwell_histogram_count(int adType, int state, int bucket)
+{
+	SCB_PROFILE_BINDING();
+	return getDwellHistogramCount(adType, state, bucket);
+}
+DEFINE_PRIME3(samcodeschartboost_get_dwell_histogram_count);
+
+int samcodeschartboost_get_illegal_transition_count()
+{
+	SCB_PROFILE_BINDING();
+	return getIllegalTransitionCount();
+}
+DEFINE_PRIME0(samcodeschartboost_get_illegal_transition_count);
+
+void samcodeschartboost_reset_location_stats()
+{
+	SCB_PROFILE_BINDING();
+	resetLocationStats();
+}
+DEFINE_PRIME0v(samcodeschartboost_reset_location_stats);
+
+void samcodeschartboost_set_event_delivery_mode(int mode)
+{
+	SCB_PROFILE_BINDING();
+	setEventDeliveryMode(mode);
+}
+DEFINE_PRIME1v(samcodeschartboost_set_event_delivery_mode);
+
+int samcodeschartboost_get_dropped_event_count()
+{
+	SCB_PROFILE_BINDING();
+	return getDroppedEventCount();
+}
+DEFINE_PRIME0(samcodeschartboost_get_dropped_event_count);
+
+void samcodeschartboost_set_event_coalescing(bool coalesce)
+{
+	SCB_PROFILE_BINDING();
+	setEventCoalescing(coalesce);
+}
+DEFINE_PRIME1v(samcodeschartboost_set_event_coalescing);
+
+void samcodeschartboost_set_stall_threshold(double seconds)
+{
+	SCB_PROFILE_BINDING();
+	setStallThreshold(seconds);
+}
+DEFINE_PRIME1v(samcodeschartboost_set_stall_threshold);
+
+void samcodeschartboost_start_stall_watchdog(double hangThreshold)
+{
+	SCB_PROFILE_BINDING();
+	startStallWatchdog(hangThreshold);
+}
+DEFINE_PRIME1v(samcodeschartboost_start_stall_watchdog);
+
+void samcodeschartboost_stop_stall_watchdog()
+{
+	SCB_PROFILE_BINDING();
+	stopStallWatchdog();
+}
+DEFINE_PRIME0v(samcodeschartboost_stop_stall_watchdog);
+
+int samcodeschartboost_get_sdk_call_count()
+{
+	SCB_PROFILE_BINDING();
+	return getStallStats().calls;
+}
+DEFINE_PRIME0(samcodeschartboost_get_sdk_call_count);
+
+int samcodeschartboost_get_stall_count()
+{
+	SCB_PROFILE_BINDING();
+	return getStallStats().stalls;
+}
+DEFINE_PRIME0(samcodeschartboost_get_stall_count);
+
+int samcodeschartboost_get_hang_count()
+{
+	SCB_PROFILE_BINDING();
+	return getStallStats().hangs;
+}
+DEFINE_PRIME0(samcodeschartboost_get_hang_count);
+
+double samcodeschartboost_get_max_stall_duration()
+{
+	SCB_PROFILE_BINDING();
+	return getStallStats().maxDuration;
+}
+DEFINE_PRIME0(samcodeschartboost_get_max_stall_duration);
+
+void samcodeschartboost_reset_stall_stats()
+{
+	SCB_PROFILE_BINDING();
+	resetStallStats();
+}
+DEFINE_PRIME0v(samcodeschartboost_reset_stall_stats);
+
+HxString samcodeschartboost_get_flight_recorder_dump()
+{
+	SCB_PROFILE_BINDING();
+	static std::string dump;
+	dump = getFlightRecorderDump();
+	return SCB_PROFILE_STRING_RESULT(HxString(dump.c_str()));
+}
+DEFINE_PRIME0(samcodeschartboost_get_flight_recorder_dump);
+
+void samcodeschartboost_start_metrics_export(HxString path, double interval)
+{
+	SCB_PROFILE_BINDING();
+	SCB_PROFILE_STRING(path);
+	startMetricsExport(path.c_str(), interval, &getScheduler());
+}
+DEFINE_PRIME2v(samcodeschartboost_start_metrics_export);
+
+void samcodeschartboost_stop_metrics_export()
+{
+	SCB_PROFILE_BINDING();
+	stopMetricsExport();
+}
+DEFINE_PRIME0v(samcodeschartboost_stop_metrics_export);
+
+HxString samcodeschartboost_get_open_metrics_text()
+{
+	SCB_PROFILE_BINDING();
+	static std::string text;
+	text = getOpenMetricsText(&getScheduler());
+	return SCB_PROFILE_STRING_RESULT(HxString(text.c_str()));
+}
+DEFINE_PRIME0(samcodeschartboost_get_open_metrics_text);
+
+void samcodeschartboost_mark_startup_milestone(int milestone, double secondsAgo)
+{
+	SCB_PROFILE_BINDING();
+	markStartupMilestone(milestone, getMonotonicTime() - secondsAgo);
+}
+DEFINE_PRIME2v(samcodeschartboost_mark_startup_milestone);
+
+HxString samcodeschartboost_get_startup_report()
+{
+	SCB_PROFILE_BINDING();
+	static std::string report;
+	report = getStartupReport();
+	return SCB_PROFILE_STRING_RESULT(HxString(report.c_str()));
+}
+DEFINE_PRIME0(samcodeschartboost_get_startup_report);
+
+HxString samcodeschartboost_get_binding_profile()
+{
+	static std::string profile;
+	profile = getBindingProfile();
+	return HxString(profile.c_str());
+}
+DEFINE_PRIME0(samcodeschartboost_get_binding_profile);
+
+void samcodeschartboost_reset_binding_profile()
+{
+	resetBindingProfile();
+}
+DEFINE_PRIME0v(samcodeschartboost_reset_binding_profile);
+
+HxString samcodeschartboost_get_allocation_audit()
+{
+	static std::string audit;
+	audit = getAllocationAudit();
+	return HxString(audit.c_str());
+}
+DEFINE_PRIME0(samcodeschartboost_get_allocation_audit);
+
+void samcodeschartboost_reset_allocation_audit()
+{
+	resetAllocationAudit();
+}
+DEFINE_PRIME0v(samcodeschartboost_reset_allocation_audit);
+
+double samcodeschartboost_get_resident_memory()
+{
+	SCB_PROFILE_BINDING();
+	return (double)getResidentMemory();
+}
+DEFINE_PRIME0(samcodeschartboost_get_resident_memory);
+
+HxString samcodeschartboost_get_memory_report()
+{
+	SCB_PROFILE_BINDING();
+	static std::string report;
+	report = getMemoryReport();
+	return SCB_PROFILE_STRING_RESULT(HxString(report.c_str()));
+}
+DEFINE_PRIME0(samcodeschartboost_get_memory_report);
+
+void samcodeschartboost_reset_memory_stats()
+{
+	SCB_PROFILE_BINDING();
+	resetMemoryStats();
+}
+DEFINE_PRIME0v(samcodeschartboost_reset_memory_stats);
+
 extern "C" void samcodeschartboost_main()
 {
 }
@@ -157,6 +896,20 @@ extern "C" int samcodeschartboost_register_prims()
 	return 0;
 }
 
+#ifdef SAMCODESCHARTBOOST_AUDIT_ALLOCATIONS
+// The event object, one slot per field, and the three strings
+static void auditEventObject(const char* type, const char* location, const char* uri)
+{
+	SCB_AUDIT_ALLOCATION(ALLOCATION_GC, sizeof(value));
+	for(int field = 0; field < 6; field++) {
+		SCB_AUDIT_ALLOCATION(ALLOCATION_GC, sizeof(value));
+	}
+	SCB_AUDIT_ALLOCATION(ALLOCATION_GC, strlen(type) + 1);
+	SCB_AUDIT_ALLOCATION(ALLOCATION_GC, strlen(location) + 1);
+	SCB_AUDIT_ALLOCATION(ALLOCATION_GC, strlen(uri) + 1);
+}
+#endif
+
 extern "C" void sendChartboostEvent(const char* type, const char* location, const char* uri, int reward_coins, int error, bool status)
 {
 	if(chartboostEventHandle == 0)
@@ -170,6 +923,9 @@ extern "C" void sendChartboostEvent(const char* type, const char* location, cons
 	alloc_field(o, val_id("reward_coins"), alloc_int(reward_coins));
 	alloc_field(o, val_id("error"), alloc_int(error));
 	alloc_field(o, val_id("status"), alloc_bool(status));
+	#ifdef SAMCODESCHARTBOOST_AUDIT_ALLOCATIONS
+	auditEventObject(type, location, uri);
+	#endif
 	val_call1(chartboostEventHandle->get(), o);
 }
 
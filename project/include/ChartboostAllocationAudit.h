@@ -0,0 +1,58 @@
+#ifndef CHARTBOOSTALLOCATIONAUDIT_H
+#define CHARTBOOSTALLOCATIONAUDIT_H
+
+#include <stddef.h>
+#include <string>
+
+namespace samcodeschartboost
+{
+	enum AllocationKind
+	{
+		ALLOCATION_NATIVE = 0, // malloc, strdup, operator new and NSString
+		ALLOCATION_GC = 1, // hxcpp objects, strings and fields
+		ALLOCATION_KIND_COUNT
+	};
+	
+	// Allocations are attributed to the innermost scope open on the calling thread, either a binding (by its index from
+	// registerBinding) or the delivery of an event (by event type). Allocations outside any scope aren't counted
+	enum AllocationScopeKind
+	{
+		ALLOCATION_SCOPE_BINDING = 0,
+		ALLOCATION_SCOPE_EVENT = 1
+	};
+	
+	class AllocationScope
+	{
+	public:
+		AllocationScope(int kind, int id);
+		~AllocationScope();
+		
+	private:
+		AllocationScope(const AllocationScope&);
+		AllocationScope& operator=(const AllocationScope&);
+		
+		int scope;
+		int previous;
+	};
+	
+	void recordAllocation(int kind, size_t bytes);
+	
+	// One line per binding or event type with a scope entered since the last reset:
+	// "<binding|event>\t<name>\t<calls>\t<native allocations>\t<native bytes>\t<gc allocations>\t<gc bytes>"
+	std::string getAllocationAudit();
+	void resetAllocationAudit();
+}
+
+// Build with SAMCODESCHARTBOOST_AUDIT_ALLOCATIONS defined to count allocations on the binding and event paths.
+// Without it these expand to nothing, and operator new isn't replaced
+#ifdef SAMCODESCHARTBOOST_AUDIT_ALLOCATIONS
+#define SCB_AUDIT_BINDING(binding) samcodeschartboost::AllocationScope allocationScope(samcodeschartboost::ALLOCATION_SCOPE_BINDING, binding)
+#define SCB_AUDIT_EVENT(type) samcodeschartboost::AllocationScope allocationScope(samcodeschartboost::ALLOCATION_SCOPE_EVENT, type)
+#define SCB_AUDIT_ALLOCATION(kind, bytes) samcodeschartboost::recordAllocation(kind, bytes)
+#else
+#define SCB_AUDIT_BINDING(binding)
+#define SCB_AUDIT_EVENT(type)
+#define SCB_AUDIT_ALLOCATION(kind, bytes)
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,15 @@
+#ifndef CHARTBOOSTANALYTICS_H
+#define CHARTBOOSTANALYTICS_H
+
+namespace samcodeschartboost
+{
+	// Level tracking is buffered natively. Repeated events for the same label and level type replace each other,
+	// and the buffer is sent to the SDK in one batch on a timer or when a flush is requested at a pause point
+	void trackLevelInfo(const char* label, int levelType, int mainLevel, int subLevel, const char* description);
+	void flushLevelInfo();
+	void requestLevelInfoFlush();
+	void setLevelInfoFlushInterval(double seconds);
+	int getPendingLevelInfoCount();
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,42 @@
+#ifndef CHARTBOOSTBINDINGPROFILER_H
+#define CHARTBOOSTBINDINGPROFILER_H
+
+#include <string>
+
+namespace samcodeschartboost
+{
+	const int MAX_PROFILED_BINDINGS = 128;
+	
+	// Returns the index of a binding for timing, registering it on first use, or -1 when the table is full.
+	// Names must be string literals or otherwise live for the lifetime of the process
+	int registerBinding(const char* name);
+	// The binding's name without the samcodeschartboost_ prefix, or "" if the index isn't registered
+	const char* getBindingName(int binding);
+	
+	// Counts a call to a binding and times it from construction to destruction, along with the string bytes it marshalled
+	class ScopedBindingTimer
+	{
+	public:
+		explicit ScopedBindingTimer(int binding);
+		~ScopedBindingTimer();
+		
+		void addStringBytes(int bytes)
+		{
+			stringBytes += bytes;
+		}
+		
+	private:
+		ScopedBindingTimer(const ScopedBindingTimer&);
+		ScopedBindingTimer& operator=(const ScopedBindingTimer&);
+		
+		int binding;
+		int stringBytes;
+		double start;
+	};
+	
+	// One line per binding that has been called, in registration order: "<name>\t<calls>\t<total seconds>\t<max seconds>\t<string bytes>"
+	std::string getBindingProfile();
+	void resetBindingProfile();
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,221 @@
+#ifndef CHARTBOOSTCAPI_H
+#define CHARTBOOSTCAPI_H
+
+#include <stdint.h>
+
+/*
+ * A plain C interface to the extension for native hosts, built into the samcodeschartboost_c static library without hxcpp.
+ * Everything here calls straight into the same native bridge the Haxe bindings use, so the two can't be mixed in one process.
+ *
+ * Strings passed in are copied before the call returns. Strings returned as const char* stay valid for the lifetime of
+ * the process. Functions that fill a buffer copy up to capacity - 1 bytes plus a terminator and return the full length,
+ * so a return value of capacity or more means the text was cut short.
+ * Booleans are ints, 0 for false and anything else for true.
+ */
+
+#define SCB_API_VERSION 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Matches the AdType, LocationState, Consent and event delivery enums of the native bridge */
+enum
+{
+	SCB_AD_TYPE_INTERSTITIAL = 0,
+	SCB_AD_TYPE_REWARDED_VIDEO = 1
+};
+
+enum
+{
+	SCB_LOCATION_IDLE = 0,
+	SCB_LOCATION_REQUESTING = 1,
+	SCB_LOCATION_CACHED = 2,
+	SCB_LOCATION_SHOWING = 3,
+	SCB_LOCATION_DISPLAYED = 4,
+	SCB_LOCATION_CLOSED = 5,
+	SCB_LOCATION_FAILED = 6
+};
+
+enum
+{
+	SCB_CONSENT_UNKNOWN = -1,
+	SCB_CONSENT_NO_BEHAVIORAL = 0,
+	SCB_CONSENT_YES_BEHAVIORAL = 1
+};
+
+enum
+{
+	SCB_CONSENT_CHANGE_KEEP = 0,
+	SCB_CONSENT_CHANGE_INVALIDATE = 1,
+	SCB_CONSENT_CHANGE_RECACHE = 2
+};
+
+enum
+{
+	SCB_EVENT_DELIVERY_HANDLER = 0, /* Events go to the handler set with scb_set_event_handler, with their names and locations as strings */
+	SCB_EVENT_DELIVERY_RING = 1,
+	SCB_EVENT_DELIVERY_CALLBACK = 2,
+	SCB_EVENT_DELIVERY_LISTENERS = 3
+};
+
+/* One slot of the event ring, read in place. Same layout as the native ChartboostEvent: 32 bytes, no padding */
+typedef struct scb_event
+{
+	int32_t type; /* Event type id, see ChartboostEventTable.h and scb_get_event_name */
+	int32_t location; /* Location index, or -1 */
+	int32_t error; /* Error id as reported by the SDK, or -1 */
+	int32_t reward;
+	int32_t status;
+	int32_t reserved;
+	double time; /* Monotonic seconds when the event was pushed */
+} scb_event;
+
+typedef struct scb_scheduler_policy
+{
+	int max_in_flight;
+	int max_retries;
+	double retry_backoff;
+	double request_timeout;
+	int defer_outside_idle;
+} scb_scheduler_policy;
+
+typedef struct scb_scheduler_stats
+{
+	int requested;
+	int issued;
+	int urgent_issued;
+	int issued_outside_idle;
+	int succeeded;
+	int failed;
+	int retries;
+	int timeouts;
+	int already_cached;
+	double total_queue_time;
+	double total_cache_time;
+} scb_scheduler_stats;
+
+typedef struct scb_stall_stats
+{
+	int calls;
+	int stalls;
+	int hangs;
+	double max_duration;
+} scb_stall_stats;
+
+typedef struct scb_memory_stats
+{
+	long long before_init; /* Bytes, or -1 if not sampled */
+	long long after_init;
+	long long last_sample;
+	long long peak_sample;
+	int samples;
+} scb_memory_stats;
+
+/* All callbacks are called on the main thread */
+typedef void (*scb_event_handler)(const char* type, const char* location, const char* uri, int reward, int error, int status, void* user_data);
+typedef void (*scb_event_callback)(int type, int location, int error, int reward, int status, void* user_data);
+typedef void (*scb_listener_callback)(int listener, int type, int location, int error, int reward, int status, void* user_data);
+
+int scb_get_api_version(void);
+
+/* Commands */
+void scb_init(const char* app_id, const char* app_signature);
+void scb_show_interstitial(const char* location);
+void scb_cache_interstitial(const char* location);
+int scb_has_interstitial(const char* location);
+void scb_show_rewarded_video(const char* location);
+void scb_cache_rewarded_video(const char* location);
+int scb_has_rewarded_video(const char* location);
+int scb_is_any_view_visible(void);
+void scb_set_custom_id(const char* id);
+int scb_get_custom_id(char* buffer, int capacity);
+void scb_set_should_request_interstitials_in_first_session(int should_request);
+int scb_get_auto_cache_ads(void);
+void scb_set_auto_cache_ads(int auto_cache);
+void scb_set_should_prefetch_video_content(int should_prefetch);
+int scb_get_sdk_version(char* buffer, int capacity);
+void scb_set_muted(int mute);
+
+/* Consent is cached natively and persisted between launches, see ChartboostConsent.h */
+int scb_get_consent(void);
+void scb_set_consent(int consent);
+void scb_set_consent_change_policy(int policy);
+int scb_is_consent_stale(int ad_type, int location_index);
+
+/* Ad objects and banners are referred to by handle, 0 is never a valid handle */
+int scb_create_ad(int ad_type, const char* location);
+void scb_release_ad(int handle);
+void scb_cache_ad(int handle);
+void scb_show_ad(int handle);
+int scb_is_ad_cached(int handle);
+
+int scb_acquire_banner(const char* location, int size);
+void scb_release_banner(int handle);
+void scb_show_banner(int handle);
+void scb_hide_banner(int handle);
+void scb_set_banner_position(int handle, double x, double y);
+void scb_set_banner_refresh_interval(int handle, double seconds);
+int scb_is_banner_cached(int handle);
+void scb_update_banners(double dt, int frame_budget_tight);
+
+void scb_track_level_info(const char* label, int level_type, int main_level, int sub_level, const char* description);
+void scb_flush_level_info(void);
+void scb_track_in_app_purchase(const unsigned char* receipt, int receipt_length, const char* title, const char* description, const char* price, const char* currency, const char* product_id);
+
+/* Events */
+void scb_set_event_delivery_mode(int mode);
+int scb_get_event_delivery_mode(void);
+void scb_set_event_handler(scb_event_handler handler, void* user_data);
+/* Setting a callback switches to callback delivery, clearing it switches back to the handler */
+void scb_set_event_callback(scb_event_callback callback, void* user_data);
+void scb_clear_event_callback(void);
+void scb_set_event_coalescing(int coalesce);
+const char* scb_get_event_name(int type);
+
+/* The event ring is single consumer. Read the slots between the read and write indices (both wrap), then commit the new read index */
+const scb_event* scb_get_event_ring(void);
+int scb_get_event_ring_capacity(void);
+uint32_t scb_get_event_write_index(void);
+uint32_t scb_get_event_read_index(void);
+void scb_commit_event_read_index(uint32_t index);
+int scb_get_dropped_event_count(void);
+
+/* Adding a listener switches to listener delivery, removing the last one switches back to the mode that was active before the first was added */
+void scb_set_listener_callback(scb_listener_callback callback, void* user_data);
+/* Returns -1 once the maximum number of listeners are registered */
+int scb_add_listener(int mask, int priority);
+void scb_remove_listener(int listener);
+void scb_set_listener_mask(int listener, int mask);
+
+/* Locations */
+int scb_get_location_index(const char* location);
+const char* scb_get_location_name(int index);
+int scb_get_location_state(int ad_type, int location_index);
+
+/* Scheduler */
+void scb_request_cache(int ad_type, const char* location, int urgent);
+void scb_begin_idle_window(void);
+void scb_end_idle_window(void);
+/* Updates the predictor and the scheduler, call this regularly */
+void scb_update_scheduler(void);
+void scb_set_scheduler_policy(const scb_scheduler_policy* policy);
+void scb_get_scheduler_policy(scb_scheduler_policy* policy);
+int scb_get_scheduler_pending_count(void);
+int scb_get_scheduler_in_flight_count(void);
+void scb_get_scheduler_stats(scb_scheduler_stats* stats);
+
+/* Stats */
+int scb_get_error_count(int code);
+const char* scb_get_error_name(int code);
+void scb_get_stall_stats(scb_stall_stats* stats);
+void scb_get_memory_stats(scb_memory_stats* stats);
+int scb_get_open_metrics_text(char* buffer, int capacity);
+int scb_get_startup_report(char* buffer, int capacity);
+int scb_get_memory_report(char* buffer, int capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
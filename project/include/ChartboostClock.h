@@ -0,0 +1,10 @@
+#ifndef CHARTBOOSTCLOCK_H
+#define CHARTBOOSTCLOCK_H
+
+namespace samcodeschartboost
+{
+	// Monotonic time in seconds, used for all native timing
+	double getMonotonicTime();
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef CHARTBOOSTCONSENT_H
+#define CHARTBOOSTCONSENT_H
+
+namespace samcodeschartboost
+{
+	// Matches CBPIDataUseConsent
+	enum Consent
+	{
+		CONSENT_UNKNOWN = -1,
+		CONSENT_NO_BEHAVIORAL = 0,
+		CONSENT_YES_BEHAVIORAL = 1
+	};
+	
+	// What a consent change does to placements that were requested under the old consent. The SDK ignores cache requests
+	// for placements it already holds an ad for, so those can only be requested again once their ad has been shown
+	enum ConsentChangePolicy
+	{
+		CONSENT_CHANGE_KEEP = 0, // Placements requested under the old consent are treated as current
+		CONSENT_CHANGE_INVALIDATE = 1, // Placements requested or cached under the old consent are marked stale
+		CONSENT_CHANGE_RECACHE = 2 // As invalidate, and stale placements are requested again through the scheduler once their ad is shown
+	};
+	
+	// Consent is kept natively and persisted between launches, so reads never go through the SDK.
+	// The persisted value is read on first use, the SDK is only asked on a launch where nothing has been persisted yet
+	int getConsent();
+	// Sends the consent to the SDK, handles placements requested under the old consent according to the change policy, and persists it.
+	// Setting the current consent again does nothing
+	void changeConsent(int consent);
+	// Sends the persisted consent to the SDK, if there is one. Called before the SDK starts
+	void applyPersistedConsent();
+	
+	void setConsentChangePolicy(int policy);
+	int getConsentChangePolicy();
+	
+	// Called when a cache request goes out for a placement, or a cache the SDK started on its own completes, tying it to the consent in force
+	void noteConsentRequest(int adType, int locationIndex);
+	// Called when a placement's ad has been shown, so a stale placement can be requested again under the recache policy
+	void onConsentPlacementDisplayed(int adType, const char* location, double now);
+	// Whether the placement is requesting or holding an ad that was requested before the last consent change
+	bool isConsentStale(int adType, int locationIndex);
+	int getConsentChangeCount();
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,351 @@
+#ifndef CHARTBOOSTCPPAPI_H
+#define CHARTBOOSTCPPAPI_H
+
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "ChartboostCApi.h"
+
+// A thin C++17 layer over the C interface in ChartboostCApi.h, with RAII handles and std::string_view arguments.
+// Header only, so it works with any compiler the host uses and only the C interface crosses the library boundary
+namespace scb
+{
+	namespace detail
+	{
+		// string_view isn't null terminated, so arguments are copied into a terminated buffer, on the stack for the short strings locations usually are
+		class CString
+		{
+		public:
+			explicit CString(std::string_view s)
+			{
+				if(s.size() < sizeof(small)) {
+					s.copy(small, s.size());
+					small[s.size()] = '\0';
+					pointer = small;
+				} else {
+					large.assign(s.data(), s.size());
+					pointer = large.c_str();
+				}
+			}
+			
+			CString(const CString&) = delete;
+			CString& operator=(const CString&) = delete;
+			
+			const char* c_str() const
+			{
+				return pointer;
+			}
+		
+		private:
+			char small[128];
+			std::string large;
+			const char* pointer;
+		};
+		
+		// Calls a C function that fills a buffer, growing the buffer once if the first call cut the text short
+		template<typename Fill>
+		std::string readText(Fill fill)
+		{
+			std::string text(256, '\0');
+			int length = fill(&text[0], (int)text.size());
+			if(length >= (int)text.size()) {
+				text.resize(length + 1);
+				length = fill(&text[0], (int)text.size());
+			}
+			text.resize(length < (int)text.size() ? length : text.size() - 1);
+			return text;
+		}
+		
+		// Owns a handle from the C interface and releases it on destruction. Handles are moved, never copied
+		template<void (*Release)(int)>
+		class UniqueHandle
+		{
+		public:
+			UniqueHandle() : handle(0) {}
+			explicit UniqueHandle(int handle) : handle(handle) {}
+			~UniqueHandle()
+			{
+				reset();
+			}
+			
+			UniqueHandle(UniqueHandle&& other) noexcept : handle(std::exchange(other.handle, 0)) {}
+			UniqueHandle& operator=(UniqueHandle&& other) noexcept
+			{
+				if(this != &other) {
+					reset();
+					handle = std::exchange(other.handle, 0);
+				}
+				return *this;
+			}
+			
+			UniqueHandle(const UniqueHandle&) = delete;
+			UniqueHandle& operator=(const UniqueHandle&) = delete;
+			
+			int get() const
+			{
+				return handle;
+			}
+			
+			explicit operator bool() const
+			{
+				return handle != 0;
+			}
+			
+			void reset()
+			{
+				if(handle != 0) {
+					Release(handle);
+					handle = 0;
+				}
+			}
+		
+		private:
+			int handle;
+		};
+	}
+	
+	inline void init(std::string_view appId, std::string_view appSignature)
+	{
+		scb_init(detail::CString(appId).c_str(), detail::CString(appSignature).c_str());
+	}
+	
+	inline void showInterstitial(std::string_view location)
+	{
+		scb_show_interstitial(detail::CString(location).c_str());
+	}
+	
+	inline void cacheInterstitial(std::string_view location)
+	{
+		scb_cache_interstitial(detail::CString(location).c_str());
+	}
+	
+	inline bool hasInterstitial(std::string_view location)
+	{
+		return scb_has_interstitial(detail::CString(location).c_str()) != 0;
+	}
+	
+	inline void showRewardedVideo(std::string_view location)
+	{
+		scb_show_rewarded_video(detail::CString(location).c_str());
+	}
+	
+	inline void cacheRewardedVideo(std::string_view location)
+	{
+		scb_cache_rewarded_video(detail::CString(location).c_str());
+	}
+	
+	inline bool hasRewardedVideo(std::string_view location)
+	{
+		return scb_has_rewarded_video(detail::CString(location).c_str()) != 0;
+	}
+	
+	inline void setCustomId(std::string_view id)
+	{
+		scb_set_custom_id(detail::CString(id).c_str());
+	}
+	
+	inline std::string getCustomId()
+	{
+		return detail::readText(scb_get_custom_id);
+	}
+	
+	inline std::string getSdkVersion()
+	{
+		return detail::readText(scb_get_sdk_version);
+	}
+	
+	inline int getConsent()
+	{
+		return scb_get_consent();
+	}
+	
+	inline void setConsent(int consent)
+	{
+		scb_set_consent(consent);
+	}
+	
+	inline void trackLevelInfo(std::string_view label, int levelType, int mainLevel, int subLevel, std::string_view description)
+	{
+		scb_track_level_info(detail::CString(label).c_str(), levelType, mainLevel, subLevel, detail::CString(description).c_str());
+	}
+	
+	inline int getLocationIndex(std::string_view location)
+	{
+		return scb_get_location_index(detail::CString(location).c_str());
+	}
+	
+	inline void requestCache(int adType, std::string_view location, bool urgent = false)
+	{
+		scb_request_cache(adType, detail::CString(location).c_str(), urgent ? 1 : 0);
+	}
+	
+	inline std::string getOpenMetricsText()
+	{
+		return detail::readText(scb_get_open_metrics_text);
+	}
+	
+	inline std::string getStartupReport()
+	{
+		return detail::readText(scb_get_startup_report);
+	}
+	
+	inline std::string getMemoryReport()
+	{
+		return detail::readText(scb_get_memory_report);
+	}
+	
+	// An interstitial or rewarded video ad object, released when it goes out of scope
+	class Ad
+	{
+	public:
+		Ad() = default;
+		Ad(int adType, std::string_view location) : handle(scb_create_ad(adType, detail::CString(location).c_str())) {}
+		
+		void cache()
+		{
+			scb_cache_ad(handle.get());
+		}
+		
+		void show()
+		{
+			scb_show_ad(handle.get());
+		}
+		
+		bool isCached() const
+		{
+			return scb_is_ad_cached(handle.get()) != 0;
+		}
+		
+		int get() const
+		{
+			return handle.get();
+		}
+		
+		explicit operator bool() const
+		{
+			return static_cast<bool>(handle);
+		}
+	
+	private:
+		detail::UniqueHandle<scb_release_ad> handle;
+	};
+	
+	// A banner from the native pool, hidden and returned to the pool when it goes out of scope
+	class Banner
+	{
+	public:
+		Banner() = default;
+		Banner(std::string_view location, int size) : handle(scb_acquire_banner(detail::CString(location).c_str(), size)) {}
+		
+		void show()
+		{
+			scb_show_banner(handle.get());
+		}
+		
+		void hide()
+		{
+			scb_hide_banner(handle.get());
+		}
+		
+		void setPosition(double x, double y)
+		{
+			scb_set_banner_position(handle.get(), x, y);
+		}
+		
+		void setRefreshInterval(double seconds)
+		{
+			scb_set_banner_refresh_interval(handle.get(), seconds);
+		}
+		
+		bool isCached() const
+		{
+			return scb_is_banner_cached(handle.get()) != 0;
+		}
+		
+		int get() const
+		{
+			return handle.get();
+		}
+		
+		explicit operator bool() const
+		{
+			return static_cast<bool>(handle);
+		}
+	
+	private:
+		detail::UniqueHandle<scb_release_banner> handle;
+	};
+	
+	// A subscription to the event types in a mask (bit n for event type n), removed when it goes out of scope.
+	// Events arrive through the callback set with scb_set_listener_callback
+	class Listener
+	{
+	public:
+		Listener() = default;
+		Listener(int mask, int priority) : handle(add(mask, priority)) {}
+		
+		void setMask(int mask)
+		{
+			scb_set_listener_mask(handle.get(), mask);
+		}
+		
+		int get() const
+		{
+			return handle.get();
+		}
+		
+		// False if the listener couldn't be added because too many are registered
+		explicit operator bool() const
+		{
+			return static_cast<bool>(handle);
+		}
+	
+	private:
+		// Listener ids start at 1, so the -1 returned on failure becomes the empty handle
+		static int add(int mask, int priority)
+		{
+			int listener = scb_add_listener(mask, priority);
+			return listener > 0 ? listener : 0;
+		}
+		
+		detail::UniqueHandle<scb_remove_listener> handle;
+	};
+	
+	// Marks a stretch where loading ads won't hurt, like a loading screen, for as long as it's in scope
+	class IdleWindow
+	{
+	public:
+		IdleWindow()
+		{
+			scb_begin_idle_window();
+		}
+		
+		~IdleWindow()
+		{
+			scb_end_idle_window();
+		}
+		
+		IdleWindow(const IdleWindow&) = delete;
+		IdleWindow& operator=(const IdleWindow&) = delete;
+	};
+	
+	// Calls the visitor with each unread slot of the event ring in order, then marks them read. Returns how many were read.
+	// The ring is single consumer, so only one thread should drain it. Its capacity is a power of two
+	template<typename Visitor>
+	int drainEvents(Visitor&& visitor)
+	{
+		const scb_event* ring = scb_get_event_ring();
+		uint32_t capacity = (uint32_t)scb_get_event_ring_capacity();
+		uint32_t read = scb_get_event_read_index();
+		uint32_t write = scb_get_event_write_index();
+		int count = 0;
+		for(; read != write; read++, count++) {
+			visitor(ring[read & (capacity - 1)]);
+		}
+		scb_commit_event_read_index(read);
+		return count;
+	}
+}
+
+#endif
\ No newline at end of file
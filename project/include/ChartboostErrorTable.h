@@ -0,0 +1,50 @@
+// The Chartboost error taxonomy. Maps the platform error codes onto one stable set of error codes.
+// This file is expanded with CHARTBOOST_ERROR defined by the native code, and is parsed by ChartboostErrorMacro to generate the Haxe side.
+// Update it whenever the Chartboost SDK is updated/changes or adds new errors. Stable ids must stay contiguous and must never be reused.
+//
+// On iOS the impression column covers CBLoadError, CHBCacheErrorCode and CHBShowErrorCode, which share their numbering.
+// The click columns cover CBClickError and CHBClickErrorCode on iOS and CBClickError on Android. The Android columns are CBImpressionError and CBClickError ordinals.
+// Unused platform codes are -1.
+//
+// CHARTBOOST_ERROR(name, stable id, iOS impression, iOS click, Android impression, Android click, retryable)
+
+CHARTBOOST_ERROR(INTERNAL, 0, 0, -1, 0, -1, true)
+CHARTBOOST_ERROR(INTERNET_UNAVAILABLE, 1, 1, -1, 1, -1, true)
+CHARTBOOST_ERROR(TOO_MANY_CONNECTIONS, 2, 2, -1, 2, -1, true)
+CHARTBOOST_ERROR(WRONG_ORIENTATION, 3, 3, -1, 3, -1, false)
+CHARTBOOST_ERROR(FIRST_SESSION_INTERSTITIALS_DISABLED, 4, 4, -1, 4, -1, false)
+CHARTBOOST_ERROR(NETWORK_FAILURE, 5, 5, -1, 5, -1, true)
+CHARTBOOST_ERROR(NO_AD_FOUND, 6, 6, -1, 6, -1, true)
+CHARTBOOST_ERROR(SESSION_NOT_STARTED, 7, 7, -1, 7, -1, true)
+CHARTBOOST_ERROR(IMPRESSION_ALREADY_VISIBLE, 8, 8, -1, 8, -1, false)
+CHARTBOOST_ERROR(NO_HOST_ACTIVITY, 9, -1, -1, 9, -1, false)
+CHARTBOOST_ERROR(USER_CANCELLATION, 10, 10, -1, 10, -1, false)
+CHARTBOOST_ERROR(INVALID_LOCATION, 11, 11, -1, 11, -1, false)
+CHARTBOOST_ERROR(VIDEO_UNAVAILABLE, 12, -1, -1, 12, -1, true)
+CHARTBOOST_ERROR(VIDEO_ID_MISSING, 13, -1, -1, 13, -1, false)
+CHARTBOOST_ERROR(ERROR_PLAYING_VIDEO, 14, -1, -1, 14, -1, true)
+CHARTBOOST_ERROR(INVALID_RESPONSE, 15, -1, -1, 15, -1, true)
+CHARTBOOST_ERROR(ASSET_DOWNLOAD_FAILURE, 16, 16, -1, 16, -1, true)
+CHARTBOOST_ERROR(ERROR_CREATING_VIEW, 17, -1, -1, 17, -1, false)
+CHARTBOOST_ERROR(ERROR_DISPLAYING_VIEW, 18, -1, -1, 18, -1, false)
+CHARTBOOST_ERROR(INCOMPATIBLE_API_VERSION, 19, -1, -1, 19, -1, false)
+CHARTBOOST_ERROR(ERROR_LOADING_WEB_VIEW, 20, -1, -1, 20, -1, true)
+CHARTBOOST_ERROR(PREFETCHING_INCOMPLETE, 21, 21, -1, 21, -1, true)
+CHARTBOOST_ERROR(WEB_VIEW_SCRIPT_ERROR, 22, 22, -1, -1, -1, false)
+CHARTBOOST_ERROR(ACTIVITY_MISSING_IN_MANIFEST, 23, -1, -1, 22, -1, false)
+CHARTBOOST_ERROR(EMPTY_LOCAL_VIDEO_LIST, 24, -1, -1, 23, -1, true)
+CHARTBOOST_ERROR(END_POINT_DISABLED, 25, -1, -1, 24, -1, false)
+CHARTBOOST_ERROR(HARDWARE_ACCELERATION_DISABLED, 26, -1, -1, 25, -1, false)
+CHARTBOOST_ERROR(PENDING_IMPRESSION_ERROR, 27, -1, -1, 26, -1, true)
+CHARTBOOST_ERROR(VIDEO_UNAVAILABLE_FOR_CURRENT_ORIENTATION, 28, -1, -1, 27, -1, false)
+CHARTBOOST_ERROR(ASSET_MISSING, 29, -1, -1, 28, -1, true)
+CHARTBOOST_ERROR(WEB_VIEW_PAGE_LOAD_TIMEOUT, 30, -1, -1, 29, -1, true)
+CHARTBOOST_ERROR(WEB_VIEW_CLIENT_RECEIVED_ERROR, 31, -1, -1, 30, -1, true)
+CHARTBOOST_ERROR(INTERNET_UNAVAILABLE_AT_SHOW, 32, 25, -1, 31, -1, true)
+CHARTBOOST_ERROR(AD_PRESENTATION_FAILURE, 33, 33, -1, -1, -1, false)
+CHARTBOOST_ERROR(NO_CACHED_AD, 34, 34, -1, -1, -1, true)
+CHARTBOOST_ERROR(CLICK_URI_INVALID, 35, -1, 0, -1, 0, false)
+CHARTBOOST_ERROR(CLICK_URI_UNRECOGNIZED, 36, -1, 1, -1, 1, false)
+CHARTBOOST_ERROR(CLICK_AGE_GATE_FAILURE, 37, -1, 2, -1, 2, false)
+CHARTBOOST_ERROR(CLICK_NO_HOST_ACTIVITY, 38, -1, -1, -1, 3, false)
+CHARTBOOST_ERROR(CLICK_INTERNAL, 39, -1, 3, -1, 4, false)
@@ -0,0 +1,35 @@
+#ifndef CHARTBOOSTERRORS_H
+#define CHARTBOOSTERRORS_H
+
+namespace samcodeschartboost
+{
+	// Stable error codes, generated from ChartboostErrorTable.h
+	enum ErrorCode
+	{
+		ERROR_UNKNOWN = -1,
+		#define CHARTBOOST_ERROR(name, id, iosImpression, iosClick, androidImpression, androidClick, retryable) ERROR_##name = id,
+		#include "ChartboostErrorTable.h"
+		#undef CHARTBOOST_ERROR
+		ERROR_CODE_COUNT
+	};
+	
+	enum ErrorDomain
+	{
+		ERROR_DOMAIN_IMPRESSION = 0,
+		ERROR_DOMAIN_CLICK = 1
+	};
+	
+	// Maps an error code reported by the SDK on the platform being built for onto a stable error code
+	int classifyError(int domain, int platformCode);
+	bool isErrorRetryable(int code);
+	const char* getErrorName(int code);
+	// The stable error code with the given name, or ERROR_UNKNOWN
+	int findErrorCode(const char* name);
+	
+	// Per stable error code counters, counted as the SDK reports errors
+	int recordError(int domain, int platformCode);
+	int getErrorCount(int code);
+	void resetErrorCounts();
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,28 @@
+// The events the extension delivers to Haxe. Expanded with CHARTBOOST_EVENT defined by the native code.
+// Ids are part of the event ring layout read from Haxe, so they must stay contiguous and must never be reused. Parsed by ChartboostEventMacro to generate ChartboostEventType.
+//
+// CHARTBOOST_EVENT(name, id, listener callback name)
+
+CHARTBOOST_EVENT(DID_INITIALIZE, 0, didInitialize)
+CHARTBOOST_EVENT(SHOULD_REQUEST_INTERSTITIAL, 1, shouldRequestInterstitial)
+CHARTBOOST_EVENT(SHOULD_DISPLAY_INTERSTITIAL, 2, shouldDisplayInterstitial)
+CHARTBOOST_EVENT(DID_DISPLAY_INTERSTITIAL, 3, didDisplayInterstitial)
+CHARTBOOST_EVENT(DID_CACHE_INTERSTITIAL, 4, didCacheInterstitial)
+CHARTBOOST_EVENT(DID_FAIL_TO_LOAD_INTERSTITIAL, 5, didFailToLoadInterstitial)
+CHARTBOOST_EVENT(DID_DISMISS_INTERSTITIAL, 6, didDismissInterstitial)
+CHARTBOOST_EVENT(DID_CLOSE_INTERSTITIAL, 7, didCloseInterstitial)
+CHARTBOOST_EVENT(DID_CLICK_INTERSTITIAL, 8, didClickInterstitial)
+CHARTBOOST_EVENT(DID_FAIL_TO_RECORD_CLICK, 9, didFailToRecordClick)
+CHARTBOOST_EVENT(SHOULD_DISPLAY_REWARDED_VIDEO, 10, shouldDisplayRewardedVideo)
+CHARTBOOST_EVENT(DID_DISPLAY_REWARDED_VIDEO, 11, didDisplayRewardedVideo)
+CHARTBOOST_EVENT(DID_CACHE_REWARDED_VIDEO, 12, didCacheRewardedVideo)
+CHARTBOOST_EVENT(DID_FAIL_TO_LOAD_REWARDED_VIDEO, 13, didFailToLoadRewardedVideo)
+CHARTBOOST_EVENT(DID_DISMISS_REWARDED_VIDEO, 14, didDismissRewardedVideo)
+CHARTBOOST_EVENT(DID_CLOSE_REWARDED_VIDEO, 15, didCloseRewardedVideo)
+CHARTBOOST_EVENT(DID_CLICK_REWARDED_VIDEO, 16, didClickRewardedVideo)
+CHARTBOOST_EVENT(DID_COMPLETE_REWARDED_VIDEO, 17, didCompleteRewardedVideo)
+CHARTBOOST_EVENT(WILL_DISPLAY_VIDEO, 18, willDisplayVideo)
+CHARTBOOST_EVENT(DID_CACHE_BANNER, 19, didCacheBanner)
+CHARTBOOST_EVENT(WILL_SHOW_BANNER, 20, willShowBanner)
+CHARTBOOST_EVENT(DID_SHOW_BANNER, 21, didShowBanner)
+CHARTBOOST_EVENT(DID_CLICK_BANNER, 22, didClickBanner)
\ No newline at end of file
@@ -0,0 +1,22 @@
+#ifndef CHARTBOOSTFLIGHTRECORDER_H
+#define CHARTBOOSTFLIGHTRECORDER_H
+
+#include <string>
+
+namespace samcodeschartboost
+{
+	enum FlightRecordKind
+	{
+		FLIGHT_STALL = 0, // An SDK call returned after taking longer than the stall threshold
+		FLIGHT_HANG = 1 // An SDK call hasn't returned after the hang threshold, seen by the watchdog
+	};
+	
+	// Keeps the most recent notable events in a fixed ring, for dumping after something goes wrong.
+	// Names must be string literals or otherwise live for the lifetime of the process
+	void recordFlightEvent(int kind, const char* name, int location, double value);
+	
+	// One line per record, oldest first: "<time> <kind> <name> <location> <value>"
+	std::string getFlightRecorderDump();
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,18 @@
+#ifndef CHARTBOOSTLOCATIONS_H
+#define CHARTBOOSTLOCATIONS_H
+
+namespace samcodeschartboost
+{
+	const int MAX_LOCATIONS = 256;
+	
+	// Maps location names to small stable indices, so per-location state can live in flat arrays.
+	// Returns -1 once MAX_LOCATIONS distinct locations have been seen
+	int internLocation(const char* location);
+	// Returns -1 for locations that haven't been interned
+	int findLocation(const char* location);
+	// Stays valid for the lifetime of the process
+	const char* getLocationName(int index);
+	int getLocationCount();
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,60 @@
+#ifndef CHARTBOOSTMEMORY_H
+#define CHARTBOOSTMEMORY_H
+
+#include <string>
+
+namespace samcodeschartboost
+{
+	// Lifecycle points where resident memory is sampled
+	enum MemorySamplePoint
+	{
+		MEMORY_BEFORE_INIT = 0,
+		MEMORY_AFTER_INIT = 1, // When the SDK reports that it has initialized, since it finishes asynchronously
+		MEMORY_DID_CACHE = 2,
+		MEMORY_DID_CLOSE = 3,
+		MEMORY_CACHE_START = 4, // A cache request went to the SDK
+		MEMORY_SHOW_START = 5, // The SDK is about to display the placement
+		MEMORY_SAMPLE_POINT_COUNT
+	};
+	
+	struct MemoryStats
+	{
+		long long beforeInit; // Bytes, or -1 if not sampled
+		long long afterInit;
+		long long lastSample;
+		long long peakSample;
+		int samples;
+	};
+	
+	// Memory attributed to one placement. A cache is charged the change in resident memory from its request going to the SDK to
+	// the SDK caching it, and a close the change from the SDK starting to display it to it closing. Anything else the process
+	// allocated in those windows is picked up too, so average over many caches. Caches and shows with no start sample, like ones
+	// the SDK starts on its own, aren't charged
+	struct PlacementMemory
+	{
+		int caches;
+		long long cacheDelta; // Bytes summed over caches
+		int closes;
+		long long closeDelta; // Bytes summed over closes, usually negative as the shown ad is released
+	};
+	
+	// Resident memory of the process in bytes: task_info on iOS and macOS, /proc/self/statm on Linux and Android. Returns -1 elsewhere
+	long long getResidentMemory();
+	
+	// Samples resident memory at a lifecycle point. The ad type and location are ignored for the init points.
+	// The start points only remember the sample for the placement, it's charged at the matching cache or close
+	void sampleMemory(int point, int adType, const char* location);
+	// Forgets a placement's start sample, for a cache request that failed or a show that didn't happen
+	void cancelMemorySample(int point, int adType, const char* location);
+	
+	MemoryStats getMemoryStats();
+	PlacementMemory getPlacementMemory(int adType, int locationIndex);
+	
+	// "init\t<bytes before>\t<bytes after>", "resident\t<last sampled bytes>\t<peak sampled bytes>", then one line per placement that has been sampled:
+	// "<ad type>\t<location>\t<caches>\t<cache bytes>\t<closes>\t<close bytes>", with byte counts summed over the samples
+	std::string getMemoryReport();
+	// Clears the per placement attribution and the resident samples, the init samples are kept
+	void resetMemoryStats();
+}
+
+#endif
\ No newline at end of file
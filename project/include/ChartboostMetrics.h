@@ -0,0 +1,24 @@
+#ifndef CHARTBOOSTMETRICS_H
+#define CHARTBOOSTMETRICS_H
+
+#include <string>
+
+namespace samcodeschartboost
+{
+	class Scheduler;
+	
+	// The native stats in OpenMetrics text format: error counts, dropped events, stalls, per-location state and dwell
+	// time, dwell time histograms, resident memory and its per-placement attribution, and the scheduler's queue depth
+	// and counters if a scheduler is given
+	std::string getOpenMetricsText(const Scheduler* scheduler);
+	
+	// Writes the metrics to a temporary file next to the path and renames it over the path, so a scraper never sees a
+	// partly written file. Returns false if the file couldn't be written
+	bool writeOpenMetricsFile(const char* path, const Scheduler* scheduler);
+	
+	// Starts a background thread that writes the metrics file every interval seconds, replacing any previous export
+	void startMetricsExport(const char* path, double interval, const Scheduler* scheduler);
+	void stopMetricsExport();
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,82 @@
+#ifndef CHARTBOOSTPREDICTOR_H
+#define CHARTBOOSTPREDICTOR_H
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ChartboostScheduler.h"
+
+namespace samcodeschartboost
+{
+	struct PredictorPolicy
+	{
+		PredictorPolicy();
+		
+		double safetyFactor; // How many observed cache times ahead of a predicted show to issue the request
+		double defaultCacheTime; // Seconds assumed to cache a placement before any cache time has been observed
+		double smoothing; // Weight of the newest sample in the step and cache time averages
+	};
+	
+	// Predicts when each watched placement will next be shown from progression steps reported by the game
+	// (a level finished, the player died), and asks the scheduler to cache it just early enough given the observed time to cache.
+	// Placements that aren't watched, or that have used up their shows for the session, are never requested.
+	// The predictor observes its scheduler, so a placement whose request is given up on can be requested again
+	class Predictor : public SchedulerObserver
+	{
+	public:
+		Predictor(Scheduler& scheduler);
+		virtual ~Predictor();
+		
+		void setPolicy(const PredictorPolicy& policy);
+		PredictorPolicy getPolicy() const;
+		
+		// The placement is shown every stepsPerShow steps, at most maxShows times this session (0 for no limit)
+		void watchPlacement(int adType, const char* location, int stepsPerShow, int maxShows, double now);
+		void unwatchPlacement(int adType, const char* location);
+		
+		void reportStep(int adType, const char* location, double now);
+		void onShown(int adType, const char* location, double now);
+		void onCacheFinished(int adType, const char* location, bool success, double now);
+		virtual void onRequestDropped(int adType, const char* location, double now);
+		
+		// Issues the cache requests that are due, call this regularly
+		void update(double now);
+		
+		// Predicted seconds until the placement is next shown, or -1 if it isn't watched, is out of shows or has no estimate yet
+		double getTimeToShow(int adType, const char* location, double now) const;
+		int getIssuedCount() const;
+		
+	private:
+		struct Placement
+		{
+			int adType;
+			std::string location;
+			int stepsPerShow;
+			int maxShows;
+			int shows;
+			int stepsSinceShow;
+			double lastStepAt;
+			double stepTime; // Average seconds per step, 0 until observed
+			double cacheTime; // Average seconds to cache, 0 until observed
+			double requestedAt;
+			bool requested;
+			bool cached;
+		};
+		
+		int findPlacement(int adType, const char* location) const;
+		bool isDue(const Placement& placement, double now) const;
+		double timeToShow(const Placement& placement, double now) const;
+		
+		Scheduler& scheduler;
+		PredictorPolicy policy;
+		std::vector<Placement> placements;
+		int issuedCount;
+		mutable std::mutex mutex;
+	};
+	
+	// The predictor used by the bridge, feeding the bridge's scheduler
+	Predictor& getPredictor();
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef CHARTBOOSTPROBES_H
+#define CHARTBOOSTPROBES_H
+
+// Static tracepoints for perf, bpftrace and SystemTap, under the samcodeschartboost provider:
+//   event_enqueue(type, location)
+//   event_deliver(type, location, latency_ns), when an event is delivered or its slot committed as read from the ring
+//   command_issue(ad_type, location)
+//   command_complete(ad_type, location, error, latency_ns)
+// Locations are indices from internLocation, and error is -1 for a successful cache.
+// Each probe has a semaphore, so its arguments are only computed while a tracer is attached. Where sys/sdt.h isn't
+// available, or SAMCODESCHARTBOOST_NO_PROBES is defined, the probes compile away
+
+#if defined(__linux__) && !defined(SAMCODESCHARTBOOST_NO_PROBES) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#define SAMCODESCHARTBOOST_HAVE_PROBES 1
+#endif
+#endif
+
+#ifdef SAMCODESCHARTBOOST_HAVE_PROBES
+
+#define _SDT_HAS_SEMAPHORES 1
+#include <sys/sdt.h>
+
+extern "C"
+{
+	extern volatile unsigned short samcodeschartboost_event_enqueue_semaphore;
+	extern volatile unsigned short samcodeschartboost_event_deliver_semaphore;
+	extern volatile unsigned short samcodeschartboost_command_issue_semaphore;
+	extern volatile unsigned short samcodeschartboost_command_complete_semaphore;
+}
+
+#define SCB_PROBE_ENABLED(probe) __builtin_expect(samcodeschartboost_##probe##_semaphore != 0, 0)
+#define SCB_PROBE2(probe, a, b) DTRACE_PROBE2(samcodeschartboost, probe, a, b)
+#define SCB_PROBE3(probe, a, b, c) DTRACE_PROBE3(samcodeschartboost, probe, a, b, c)
+#define SCB_PROBE4(probe, a, b, c, d) DTRACE_PROBE4(samcodeschartboost, probe, a, b, c, d)
+
+#else
+
+// Arguments are still named so they count as used, but only ever appear behind SCB_PROBE_ENABLED and are never evaluated
+#define SCB_PROBE_ENABLED(probe) false
+#define SCB_PROBE2(probe, a, b) ((void)(a), (void)(b))
+#define SCB_PROBE3(probe, a, b, c) ((void)(a), (void)(b), (void)(c))
+#define SCB_PROBE4(probe, a, b, c, d) ((void)(a), (void)(b), (void)(c), (void)(d))
+
+#endif
+
+// Converts a duration in seconds to whole nanoseconds for a probe argument
+#define SCB_PROBE_NANOSECONDS(seconds) ((long long)((seconds) * 1e9))
+
+#endif
\ No newline at end of file
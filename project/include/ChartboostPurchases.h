@@ -0,0 +1,17 @@
+#ifndef CHARTBOOSTPURCHASES_H
+#define CHARTBOOSTPURCHASES_H
+
+namespace samcodeschartboost
+{
+	// In-app purchases are written to a persistent, memory-mapped queue file and sent to the SDK from a background thread
+	// once it has initialized and is online. Tracking starts offline until the bridge says otherwise, and the bridge logs and drops
+	// purchases whose price it can't parse. Receipts can be raw bytes, which are base64 encoded when sent
+	void queuePurchase(const unsigned char* receipt, int receiptLength, bool receiptIsBase64, const char* title, const char* description, const char* price, const char* currency, const char* productId);
+	int getQueuedPurchaseCount();
+	
+	// Gate the background drain, set from the delegate callbacks and the bridge's reachability monitor
+	void setPurchaseTrackingReady(bool ready);
+	void setPurchaseTrackingOnline(bool online);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,114 @@
+#ifndef CHARTBOOSTSCHEDULER_H
+#define CHARTBOOSTSCHEDULER_H
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace samcodeschartboost
+{
+	// Where a scheduler sends the cache requests it decides to issue
+	class SchedulerSink
+	{
+	public:
+		virtual ~SchedulerSink() {}
+		virtual void issueCache(int adType, const char* location) = 0;
+		virtual bool isCached(int adType, const char* location) = 0;
+	};
+	
+	// Told when the scheduler gives up on a request, after a non-retryable error or once its retries are used up.
+	// Called without the scheduler's mutex held
+	class SchedulerObserver
+	{
+	public:
+		virtual ~SchedulerObserver() {}
+		virtual void onRequestDropped(int adType, const char* location, double now) = 0;
+	};
+	
+	struct SchedulerPolicy
+	{
+		SchedulerPolicy();
+		
+		int maxInFlight; // Cache requests allowed in flight at once, urgent requests aren't limited by this
+		int maxRetries; // Retries after a retryable error or a timeout
+		double retryBackoff; // Seconds before the first retry, doubling with each retry after that
+		double requestTimeout; // Seconds before an unanswered request is treated as lost
+		bool deferOutsideIdle; // Whether non-urgent requests wait for an idle window
+	};
+	
+	struct SchedulerStats
+	{
+		int requested;
+		int issued;
+		int urgentIssued;
+		int issuedOutsideIdle;
+		int succeeded;
+		int failed;
+		int retries;
+		int timeouts;
+		int alreadyCached;
+		double totalQueueTime; // Seconds between a request and it being issued, summed over issued requests
+		double totalCacheTime; // Seconds between a request being issued and the SDK answering, summed over answers
+	};
+	
+	// Defers non-urgent cache requests into idle windows declared by the game (loading screens, menus, pause)
+	// so SDK network and disk work doesn't compete with gameplay frames. Time is passed in by the caller, in seconds
+	class Scheduler
+	{
+	public:
+		Scheduler(SchedulerSink* sink);
+		
+		void setPolicy(const SchedulerPolicy& policy);
+		SchedulerPolicy getPolicy() const;
+		void setObserver(SchedulerObserver* observer);
+		
+		// Requests for a placement that is already pending or in flight are merged, an urgent request upgrades a pending one
+		void request(int adType, const char* location, bool urgent, double now);
+		void beginIdleWindow(double now);
+		void endIdleWindow(double now);
+		bool isIdle() const;
+		
+		// Called when the SDK reports the result of a cache request, errorCode is a stable ErrorCode
+		void onCacheFinished(int adType, const char* location, bool success, int errorCode, double now);
+		
+		// Times out lost requests and issues retries whose backoff has passed, call this regularly
+		void update(double now);
+		
+		int getPendingCount() const;
+		int getInFlightCount() const;
+		SchedulerStats getStats() const;
+		
+	private:
+		struct Request
+		{
+			int adType;
+			std::string location;
+			bool urgent;
+			bool inFlight;
+			int attempts;
+			double requestedAt;
+			double issuedAt;
+			double notBefore;
+		};
+		
+		int findRequest(int adType, const char* location) const;
+		void retryOrDrop(size_t index, double now, std::vector<Request>& dropped);
+		void drop(size_t index, std::vector<Request>& dropped);
+		void collectIssues(double now, std::vector<Request>& issues);
+		void issue(std::vector<Request>& issues, double now);
+		void notifyDropped(const std::vector<Request>& dropped, double now);
+		
+		SchedulerSink* sink;
+		SchedulerObserver* observer;
+		SchedulerPolicy policy;
+		SchedulerStats stats;
+		std::vector<Request> requests;
+		int idleDepth;
+		mutable std::mutex mutex;
+	};
+	
+	// The scheduler used by the bridge, issuing requests to the SDK
+	Scheduler& getScheduler();
+}
+
+#endif
\ No newline at end of file
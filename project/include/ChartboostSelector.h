@@ -0,0 +1,62 @@
+#ifndef CHARTBOOSTSELECTOR_H
+#define CHARTBOOSTSELECTOR_H
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace samcodeschartboost
+{
+	// Picks between interchangeable placements with a UCB1 bandit. Each placement's reward is its cache success rate,
+	// scaled down by how long caching took, so placements that fill reliably and quickly win out
+	class Selector
+	{
+	public:
+		Selector();
+		
+		// Seconds of cache latency at which a successful cache is worth half as much as an instant one
+		void setLatencyScale(double seconds);
+		// How strongly less tried placements are favoured, sqrt(2) is standard UCB1
+		void setExploration(double exploration);
+		
+		void addCandidate(const char* group, int adType, const char* location);
+		void clearGroup(const char* group);
+		
+		// Returns the best candidate location in the group, or an empty string if the group has none
+		std::string select(const char* group) const;
+		
+		// Fed from every cache request the SDK will act on and every result, for any placement a group refers to.
+		// A request still unanswered after the scheduler's request timeout is scored as a failure
+		void onCacheRequested(int adType, const char* location, double now);
+		void onCacheFinished(int adType, const char* location, bool success, double now);
+		
+		// Number of results observed for the placement, and their average reward
+		int getPulls(int adType, const char* location) const;
+		double getMeanReward(int adType, const char* location) const;
+		
+	private:
+		// One row per placement, shared by every group that names it
+		struct Arm
+		{
+			int adType;
+			unsigned int pulls;
+			float rewardSum;
+			double requestedAt; // Negative when no request is outstanding
+		};
+		
+		void expireRequests(double now, double timeout);
+		int findArm(int adType, const char* location) const;
+		
+		std::vector<Arm> arms;
+		std::vector<std::string> armLocations;
+		std::vector<std::string> groupNames;
+		std::vector<std::vector<int> > groupArms;
+		double latencyScale;
+		double exploration;
+		mutable std::mutex mutex;
+	};
+	
+	Selector& getSelector();
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,160 @@
+#ifndef CHARTBOOSTSIMULATOR_H
+#define CHARTBOOSTSIMULATOR_H
+
+#include <istream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ChartboostScheduler.h"
+
+namespace samcodeschartboost
+{
+	enum LatencyDistribution
+	{
+		LATENCY_UNIFORM = 0, // latency plus or minus up to latencySpread
+		LATENCY_EXPONENTIAL = 1, // Mean of latency, latencySpread is unused
+		LATENCY_LOGNORMAL = 2 // Mean of latency, latencySpread is the sigma of the underlying normal
+	};
+	
+	// Scripted answers, used in order before a placement falls back to its random ones. Anything else is a stable ErrorCode
+	const int OUTCOME_FILL = -2;
+	const int OUTCOME_LOST = -3;
+	
+	// How the simulated SDK answers cache requests for a placement
+	struct SimulatedPlacement
+	{
+		SimulatedPlacement();
+		
+		int adType;
+		std::string location;
+		double fillRate; // Chance a cache request fills
+		double latency; // Mean seconds to answer a cache request
+		double latencySpread; // Depends on the distribution, see LatencyDistribution
+		int latencyDistribution;
+		double lossRate; // Chance a cache request is never answered
+		int failureCode; // Stable ErrorCode reported when a request doesn't fill
+		std::vector<int> outcomes;
+	};
+	
+	struct OfflinePeriod
+	{
+		double start;
+		double end;
+	};
+	
+	// Faults that apply to every placement
+	struct SimulatedFaults
+	{
+		SimulatedFaults();
+		
+		std::vector<OfflinePeriod> offline; // Requests made while offline fail with INTERNET_UNAVAILABLE after offlineLatency
+		double offlineLatency;
+		double reorderRate; // Chance an answer is held back by up to reorderDelay extra seconds, letting later answers overtake it
+		double reorderDelay;
+		double duplicateRate; // Chance an answer is delivered a second time, duplicateDelay seconds later
+		double duplicateDelay;
+	};
+	
+	struct SimulatedScenario
+	{
+		std::vector<SimulatedPlacement> placements;
+		SimulatedFaults faults;
+	};
+	
+	// Scenario scripts are text, one directive per line, and may be mixed into tuner traces:
+	//   placement <adType> <location> <fillRate> <latency> <latencySpread> [lossRate]
+	//   latency <adType> <location> <uniform|exponential|lognormal> <latency> <latencySpread>
+	//   failure <adType> <location> <ERROR_NAME>
+	//   outcomes <adType> <location> <fill|lost|ERROR_NAME>...
+	//   offline <start> <end>
+	//   offline_latency <seconds>
+	//   reorder <rate> <maxDelay>
+	//   duplicate <rate> <delay>
+	// Error names are from ChartboostErrorTable.h. Directives for a placement that has no placement line start it from the defaults
+	bool isScenarioDirective(const std::string& directive);
+	// Parses the rest of a line starting with a scenario directive. Returns false if it is malformed
+	bool parseScenarioDirective(const std::string& directive, std::istream& in, SimulatedScenario& scenario);
+	
+	struct SimulatorStats
+	{
+		int cacheRequests;
+		int fills;
+		int failures;
+		int lost;
+		int shows;
+		int showsAvailable;
+		int duplicateRequests; // Requests for a placement that was already cached or loading
+		int offlineFailures;
+		int reorderedAnswers;
+		int duplicatedAnswers;
+	};
+	
+	// A stand-in for the Chartboost SDK on a virtual clock, for driving a scheduler offline.
+	// Answers are delivered to the scheduler in time order as the clock is advanced. Runs are deterministic for a given seed
+	class SimulatedSdk : public SchedulerSink
+	{
+	public:
+		SimulatedSdk(unsigned int seed);
+		
+		void setScheduler(Scheduler* scheduler);
+		
+		// Placements that haven't been added answer like the default placement
+		void addPlacement(const SimulatedPlacement& placement);
+		void setDefaultPlacement(const SimulatedPlacement& placement);
+		void setFaults(const SimulatedFaults& faults);
+		void setScenario(const SimulatedScenario& scenario);
+		
+		double getTime() const;
+		// Moves the clock forward, delivering every answer due by then
+		void advance(double until);
+		
+		virtual void issueCache(int adType, const char* location);
+		virtual bool isCached(int adType, const char* location);
+		
+		// Shows the placement if it is cached, using up the cached ad. Returns whether it was available
+		bool show(int adType, const char* location);
+		
+		// Cached ads that were never shown
+		int getUnshownCount() const;
+		const SimulatorStats& getStats() const;
+		
+	private:
+		struct Answer
+		{
+			double time;
+			int adType;
+			std::string location;
+			bool success;
+			int errorCode;
+			bool duplicate; // A repeated callback, which doesn't change what is cached
+		};
+		
+		struct Cached
+		{
+			int adType;
+			std::string location;
+		};
+		
+		int findPlacement(int adType, const char* location) const;
+		int findCached(int adType, const char* location) const;
+		bool isLoading(int adType, const char* location) const;
+		bool isOffline() const;
+		int nextOutcome(int placementIndex, const SimulatedPlacement& placement);
+		double sampleLatency(const SimulatedPlacement& placement);
+		void insertAnswer(const Answer& answer);
+		
+		Scheduler* scheduler;
+		std::vector<SimulatedPlacement> placements;
+		std::vector<size_t> outcomeCursors; // Next scripted outcome of each placement
+		SimulatedPlacement defaultPlacement;
+		SimulatedFaults faults;
+		std::vector<Answer> answers; // Sorted by time
+		std::vector<Cached> cached;
+		std::mt19937 random;
+		SimulatorStats stats;
+		double now;
+	};
+}
+
+#endif
\ No newline at end of file
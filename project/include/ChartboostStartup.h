@@ -0,0 +1,30 @@
+#ifndef CHARTBOOSTSTARTUP_H
+#define CHARTBOOSTSTARTUP_H
+
+#include <string>
+
+namespace samcodeschartboost
+{
+	// Launch milestones in the order they normally happen. Only the first time each is reached is kept
+	enum StartupMilestone
+	{
+		STARTUP_NDLL_LOADED = 0, // Static initialization of the ndll, the origin of the report
+		STARTUP_PRIME_LOADER_INIT = 1, // PrimeLoader.__init__ set up the ndll search path. After the ndll's static initializers where it's linked statically, as on iOS
+		STARTUP_BINDINGS_RESOLVED = 2, // The last PrimeLoader.load of any class returned
+		STARTUP_INIT_ENTER = 3,
+		STARTUP_INIT_EXIT = 4,
+		STARTUP_SDK_STARTED = 5, // startWithAppId returned
+		STARTUP_DID_INITIALIZE = 6,
+		STARTUP_MILESTONE_COUNT
+	};
+	
+	void markStartupMilestone(int milestone, double time);
+	// Records the first successful cache of each placement
+	void markFirstCache(int adType, const char* location, double time);
+	
+	// One line per milestone reached, then one per placement that has cached, in seconds since the ndll loaded:
+	// "<milestone>\t<seconds>" and "first_cache\t<ad type>\t<location>\t<seconds>"
+	std::string getStartupReport();
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,35 @@
+#ifndef CHARTBOOSTSTATES_H
+#define CHARTBOOSTSTATES_H
+
+namespace samcodeschartboost
+{
+	enum LocationState
+	{
+		LOCATION_IDLE = 0,
+		LOCATION_REQUESTING = 1,
+		LOCATION_CACHED = 2,
+		LOCATION_SHOWING = 3,
+		LOCATION_DISPLAYED = 4,
+		LOCATION_CLOSED = 5,
+		LOCATION_FAILED = 6,
+		LOCATION_STATE_COUNT
+	};
+	
+	// Dwell times are bucketed by powers of two milliseconds: bucket 0 is under 1ms, bucket n is [2^(n-1), 2^n) ms and the last bucket is open ended
+	const int DWELL_BUCKET_COUNT = 20;
+	
+	// Moves a location to a new state from a delegate callback, adding the time spent in the old state to its dwell histogram.
+	// Illegal transitions are counted but still applied, since the SDK is the authority on what happened. Returns whether the transition was legal
+	bool advanceLocationState(int adType, const char* location, int state, double now);
+	
+	// Locations are identified by their index from internLocation, and read with a single array load
+	int getLocationState(int adType, int locationIndex);
+	// Total seconds the location has spent in the state, not counting time in its current state
+	double getLocationDwellTime(int adType, int locationIndex, int state);
+	
+	int getDwellHistogramCount(int adType, int state, int bucket);
+	int getIllegalTransitionCount();
+	void resetLocationStats();
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,13 @@
+#ifndef CHARTBOOSTTEXT_H
+#define CHARTBOOSTTEXT_H
+
+#include <string>
+
+namespace samcodeschartboost
+{
+	// Formats onto the end of the string, growing it to whatever length the text needs, so the text reports and exports
+	// never cut location, binding or event names short
+	void appendf(std::string& out, const char* format, ...) __attribute__((format(printf, 2, 3)));
+}
+
+#endif
\ No newline at end of file
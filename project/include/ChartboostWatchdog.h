@@ -0,0 +1,55 @@
+#ifndef CHARTBOOSTWATCHDOG_H
+#define CHARTBOOSTWATCHDOG_H
+
+namespace samcodeschartboost
+{
+	struct StallRecord
+	{
+		const char* call;
+		int location; // Location index, or -1
+		double duration; // Seconds, or how long it had been running when the watchdog saw it for hangs
+		bool hang;
+	};
+	
+	struct StallStats
+	{
+		int calls;
+		int stalls;
+		int hangs;
+		double maxDuration;
+	};
+	
+	const int MAX_RECENT_STALLS = 16;
+	
+	// Times a call into the SDK, from construction to destruction. Calls over the stall threshold are recorded with their
+	// location and name, in the stats and the flight recorder. Call names must be string literals. Calls made off the main thread,
+	// such as analytics sent from background threads, can't stall frames and aren't timed
+	class ScopedSdkCall
+	{
+	public:
+		ScopedSdkCall(const char* call, const char* location);
+		~ScopedSdkCall();
+		
+	private:
+		ScopedSdkCall(const ScopedSdkCall&);
+		ScopedSdkCall& operator=(const ScopedSdkCall&);
+		
+		int slot;
+		double start;
+		bool timed;
+	};
+	
+	// Calls taking longer than this are recorded as stalls, 16ms by default
+	void setStallThreshold(double seconds);
+	// Starts a watchdog thread that records calls still running after hangThreshold seconds, checking a few times per threshold.
+	// A hang is recorded once per call, and the call is still recorded as a stall if it returns
+	void startStallWatchdog(double hangThreshold);
+	void stopStallWatchdog();
+	
+	StallStats getStallStats();
+	// Copies up to MAX_RECENT_STALLS of the most recent stalls and hangs, oldest first, returning how many were copied
+	int getRecentStalls(StallRecord* out);
+	void resetStallStats();
+}
+
+#endif
\ No newline at end of file
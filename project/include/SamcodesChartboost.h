@@ -1,8 +1,52 @@
 #ifndef CHARTBOOSTEXT_H
 #define CHARTBOOSTEXT_H
 
+#include <stdint.h>
+#include <string>
+
 namespace samcodeschartboost
 {
+	enum AdType
+	{
+		AD_TYPE_INTERSTITIAL = 0,
+		AD_TYPE_REWARDED_VIDEO = 1,
+		AD_TYPE_COUNT
+	};
+	
+	enum EventType
+	{
+		#define CHARTBOOST_EVENT(name, id, callbackName) EVENT_##name = id,
+		#include "ChartboostEventTable.h"
+		#undef CHARTBOOST_EVENT
+		EVENT_TYPE_COUNT
+	};
+	
+	// One slot of the native event ring. Haxe reads these in place through ChartboostEventData, so the layout is fixed:
+	// 32 bytes, no implicit padding, fields in this order
+	struct ChartboostEvent
+	{
+		int32_t type; // EventType
+		int32_t location; // Location index from internLocation, or -1 for events without a location
+		int32_t error; // Error id as reported by the SDK, or -1
+		int32_t reward; // Reward amount for completed rewarded videos
+		int32_t status; // Status flag, 0 or 1
+		int32_t reserved;
+		double time; // Monotonic seconds when the event was pushed
+	};
+	
+	enum EventDeliveryMode
+	{
+		EVENT_DELIVERY_LISTENER = 0, // Events are sent to the Haxe listener as objects
+		EVENT_DELIVERY_RING = 1, // Events are pushed into the event ring, for Haxe to read in place
+		EVENT_DELIVERY_CALLBACK = 2, // Events are passed to the event callback as plain arguments
+		EVENT_DELIVERY_LISTENERS = 3 // Events are fanned out to the registered listeners
+	};
+	
+	// A plain function pointer into Haxe, called on the main thread. Location is an index from internLocation, or -1
+	typedef void (*EventCallback)(int type, int location, int error, int reward, bool status);
+	// Called once per interested listener for each event, with the id addListener returned
+	typedef void (*ListenerCallback)(int listener, int type, int location, int error, int reward, bool status);
+	
 	void initChartboost(const char* appId, const char* appSignature);
 	void showInterstitial(const char* location);
 	void cacheInterstitial(const char* location);
@@ -21,8 +65,91 @@ namespace samcodeschartboost
 	void setStatusBarBehavior(bool shouldHide);
 	void setMuted(bool mute);
 	void restrictDataCollection(bool shouldRestrict);
+	// These go straight to the SDK, the bindings read and change consent through the native cache in ChartboostConsent
 	int getPIDataUseConsent();
 	void setPIDataUseConsent(int consent);
+	
+	// Banners are pooled natively and referred to by handle, released banners are hidden and kept for reuse
+	int acquireBanner(const char* location, int size);
+	void releaseBanner(int handle);
+	void showBanner(int handle);
+	void hideBanner(int handle);
+	void setBannerPosition(int handle, double x, double y);
+	void setBannerRefreshInterval(int handle, double seconds);
+	bool isBannerCached(int handle);
+	void updateBanners(double dt, bool frameBudgetTight);
+	void drainBannerPool();
+	
+	// Ad objects are referred to by handle, their cache state is mirrored natively from the delegate callbacks
+	int createAd(int type, const char* location);
+	void releaseAd(int handle);
+	void cacheAd(int handle);
+	void showAd(int handle);
+	bool isAdCached(int handle);
+	
+	// InPlay native ads are referred to by handle. The icon bytes and decoded pixels are owned by the handle and
+	// stay valid until it is released, so they can be viewed in place rather than copied
+	void cacheInPlay(const char* location);
+	bool hasInPlay(const char* location);
+	int getInPlay(const char* location);
+	void releaseInPlay(int handle);
+	const char* getInPlayAppName(int handle);
+	const unsigned char* getInPlayIconData(int handle);
+	int getInPlayIconLength(int handle);
+	void decodeInPlayIcon(int handle);
+	bool isInPlayIconDecoded(int handle);
+	const unsigned char* getInPlayIconPixels(int handle);
+	int getInPlayIconWidth(int handle);
+	int getInPlayIconHeight(int handle);
+	void showInPlay(int handle);
+	void clickInPlay(int handle);
+	void clearInPlayCache(int handle);
+	
+	// Sends one level tracking event to the SDK, and schedules flushLevelInfo to run off the game thread after a delay
+	void sendLevelInfo(const char* label, int levelType, int mainLevel, int subLevel, const char* description);
+	void scheduleLevelInfoFlush(double delaySeconds);
+	
+	// Sends one in-app purchase to the SDK, called from the purchase queue's background thread.
+	// Returns false without sending anything if the price can't be parsed
+	bool sendPurchase(const char* receiptBase64, const char* title, const char* description, const char* price, const char* currency, const char* productId);
+	
+	// The event ring is single consumer. The write index is published after the slot is written, the read index is advanced by the reader
+	// once it's done with the slots, and both only ever increase (wrapping). Events pushed while the ring is full are dropped and counted
+	void setEventDeliveryMode(int mode);
+	int getEventDeliveryMode();
+	// Setting a callback switches to callback delivery, clearing it switches back to the listener
+	void setEventCallback(EventCallback callback);
+	void clearEventCallback();
+	EventCallback getEventCallback();
+	const char* getEventName(int type);
+	void pushEvent(int type, int location, int error, int reward, bool status, double time);
+	const ChartboostEvent* getEventRing();
+	int getEventRingCapacity();
+	uint32_t getEventWriteIndex();
+	uint32_t getEventReadIndex();
+	void commitEventReadIndex(uint32_t index);
+	int getDroppedEventCount();
+	
+	// With coalescing on, events for the Haxe listener, the event callback and the registered listeners are appended to the event ring
+	// instead of being sent one by one, and only one main thread wakeup is pending at a time. The wakeup delivers everything that
+	// accumulated in one batch to whichever of those is current. Events left when delivery switches to the ring stay for the ring reader
+	void setEventCoalescing(bool coalesce);
+	bool getEventCoalescing();
+	// Returns true if no wakeup was pending, in which case the caller must schedule one that calls deliverPendingEvents
+	bool markEventWakeupPending();
+	int deliverPendingEvents();
+	
+	// Listeners each subscribe to a mask of event types (bit n for EventType n) and are called in priority order, highest first,
+	// then in the order they were added. Adding a listener switches to listener fan-out delivery, removing the last one switches back
+	// to whichever mode was active before the first was added (the ring, the event callback or the Haxe listener)
+	void setListenerCallback(ListenerCallback callback);
+	int addListener(int mask, int priority);
+	void removeListener(int listener);
+	void setListenerMask(int listener, int mask);
+	void deliverToListeners(const ChartboostEvent* events, int count);
+	
+	// Path for a file the extension keeps between launches
+	std::string getStoragePath(const char* fileName);
 }
 
 #endif
\ No newline at end of file
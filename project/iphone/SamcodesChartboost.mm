@@ -2,13 +2,45 @@
 #include <stdio.h>
 #include <string.h>
 #include <objc/runtime.h>
+#include <vector>
+#include <netinet/in.h>
 #import <CoreFoundation/CoreFoundation.h>
+#import <SystemConfiguration/SystemConfiguration.h>
 #import <UIKit/UIKit.h>
 
 #import "Chartboost.h"
+#import "CBAnalytics.h"
+#import "CBInPlay.h"
+#import "CHBBanner.h"
 
+#include "ChartboostAllocationAudit.h"
+#include "ChartboostAnalytics.h"
+#include "ChartboostClock.h"
+#include "ChartboostConsent.h"
+#include "ChartboostErrors.h"
+#include "ChartboostLocations.h"
+#include "ChartboostMemory.h"
+#include "ChartboostPredictor.h"
+#include "ChartboostPurchases.h"
+#include "ChartboostScheduler.h"
+#include "ChartboostSelector.h"
+#include "ChartboostStartup.h"
+#include "ChartboostStates.h"
+#include "ChartboostWatchdog.h"
 #include "SamcodesChartboost.h"
 
+// The extension may be built with or without ARC, objects kept in native tables are retained and released through these
+#if __has_feature(objc_arc)
+#define SCB_RETAIN(x) (x)
+#define SCB_RELEASE(x)
+#else
+#define SCB_RETAIN(x) [(x) retain]
+#define SCB_RELEASE(x) [(x) release]
+#endif
+
+// Times the rest of the enclosing scope as a call into the SDK, for the stall watchdog
+#define SCB_TIME_SDK_CALL(call, location) samcodeschartboost::ScopedSdkCall sdkCallTimer(call, location)
+
 extern "C" void sendChartboostEvent(const char* type, const char* location, const char* uri, int reward_coins, int error, bool status);
 
 // Returns a deep copy of the given string as a UTF8 string
@@ -16,33 +48,233 @@ extern "C" void sendChartboostEvent(const char* type, const char* location, cons
 const char* deepCopyString(NSString* s)
 {
     if(s == nil) {
+        SCB_AUDIT_ALLOCATION(samcodeschartboost::ALLOCATION_NATIVE, 1);
         return strdup("");
     }
     const char* strUtf8Data = [s UTF8String];
     if(strUtf8Data == NULL) {
+        SCB_AUDIT_ALLOCATION(samcodeschartboost::ALLOCATION_NATIVE, 1);
         return strdup("");
     }
+    SCB_AUDIT_ALLOCATION(samcodeschartboost::ALLOCATION_NATIVE, strlen(strUtf8Data) + 1);
     return strdup(strUtf8Data);
 }
 
-void dispatchEvent(NSString* type, NSString* location, NSString* uri, int reward_coins, int error, bool status)
+// Returns an autoreleased NSString copy of the given UTF8 string
+NSString* makeNSString(const char* s)
+{
+    SCB_AUDIT_ALLOCATION(samcodeschartboost::ALLOCATION_NATIVE, strlen(s) + 1);
+    return [NSString stringWithUTF8String:s];
+}
+
+// Events go into the native event ring for Haxe to read in place, to the Haxe event callback, to the registered listeners, or to the Haxe listener.
+// Everything but the ring is called on the main thread
+void dispatchEvent(int type, NSString* location, NSString* uri, int reward_coins, int error, bool status)
 {
-    NSLog(@"Will dispatch Chartboost event: [%@]", type);
+    SCB_AUDIT_EVENT(type);
+    int mode = samcodeschartboost::getEventDeliveryMode();
+    bool coalesce = mode != samcodeschartboost::EVENT_DELIVERY_RING && samcodeschartboost::getEventCoalescing();
+    if(mode != samcodeschartboost::EVENT_DELIVERY_LISTENER || coalesce) {
+        int locationIndex = location.length > 0 ? samcodeschartboost::internLocation([location UTF8String]) : -1;
+        if(mode == samcodeschartboost::EVENT_DELIVERY_RING) {
+            samcodeschartboost::pushEvent(type, locationIndex, error, reward_coins, status, samcodeschartboost::getMonotonicTime());
+        } else if(coalesce) {
+            // The ring has no room for the uri, but no delegate callback passes one
+            samcodeschartboost::pushEvent(type, locationIndex, error, reward_coins, status, samcodeschartboost::getMonotonicTime());
+            if(samcodeschartboost::markEventWakeupPending()) {
+                dispatch_async(dispatch_get_main_queue(), ^void() {
+                    samcodeschartboost::deliverPendingEvents();
+                });
+            }
+        } else if(mode == samcodeschartboost::EVENT_DELIVERY_CALLBACK) {
+            dispatch_async(dispatch_get_main_queue(), ^void() {
+                SCB_AUDIT_EVENT(type);
+                samcodeschartboost::EventCallback callback = samcodeschartboost::getEventCallback();
+                if(callback != NULL) {
+                    callback(type, locationIndex, error, reward_coins, status);
+                }
+            });
+        } else if(mode == samcodeschartboost::EVENT_DELIVERY_LISTENERS) {
+            samcodeschartboost::ChartboostEvent event = { type, locationIndex, error, reward_coins, status ? 1 : 0, 0, samcodeschartboost::getMonotonicTime() };
+            dispatch_async(dispatch_get_main_queue(), ^void() {
+                SCB_AUDIT_EVENT(type);
+                samcodeschartboost::deliverToListeners(&event, 1);
+            });
+        }
+        return;
+    }
+    
+    const char* typeChars = samcodeschartboost::getEventName(type);
+    NSLog(@"Will dispatch Chartboost event: [%s]", typeChars);
     
-    const char* typeChars = deepCopyString(type);
     const char* locationChars = deepCopyString(location);
     const char* uriChars = deepCopyString(uri);
 
     void (^blockClosure)() = ^void() {
+        SCB_AUDIT_EVENT(type);
         sendChartboostEvent(typeChars, locationChars, uriChars, reward_coins, error, status);
         
-        free((void*)(typeChars));
         free((void*)(locationChars));
         free((void*)(uriChars));
     };
     dispatch_async(dispatch_get_main_queue(), blockClosure);
 }
 
+// Native handles pack a slot index and a generation count, so stale handles to a recycled slot are ignored
+static int makeHandle(int index, int generation)
+{
+    return (generation << 16) | (index + 1);
+}
+
+static int getHandleIndex(int handle)
+{
+    return (handle & 0xFFFF) - 1;
+}
+
+static int getHandleGeneration(int handle)
+{
+    return handle >> 16;
+}
+
+// An interstitial or rewarded video ad object. The SDK caches these per location, so the slot mirrors the cache state
+// reported through the delegate and isAdCached never has to go through the SDK or build an NSString.
+// The SDK can drop a request without calling back (before startWithAppId finishes, for one), so a request the delegate
+// never answers expires after the scheduler's request timeout and cacheAd can try again
+struct AdSlot
+{
+    NSString* location;
+    int type;
+    int generation;
+    bool inUse;
+    bool requested;
+    bool cached;
+    double requestedAt;
+};
+
+static std::vector<AdSlot> adSlots;
+
+static AdSlot* getAdSlot(int handle)
+{
+    int index = getHandleIndex(handle);
+    if(index < 0 || index >= (int)adSlots.size()) {
+        return NULL;
+    }
+    AdSlot* slot = &adSlots[index];
+    if(!slot->inUse || slot->generation != getHandleGeneration(handle)) {
+        return NULL;
+    }
+    return slot;
+}
+
+static void updateAdSlots(int type, NSString* location, bool cached)
+{
+    for(size_t i = 0; i < adSlots.size(); i++) {
+        AdSlot& slot = adSlots[i];
+        if(slot.inUse && slot.type == type && [slot.location isEqualToString:location]) {
+            slot.requested = false;
+            slot.cached = cached;
+        }
+    }
+}
+
+// Seconds purchase tracking waits after a connectivity error before trying to send again
+static const double purchaseOnlineRetrySeconds = 60.0;
+
+// Purchase tracking starts offline and follows the device's reachability. The SDK doesn't say whether a purchase got through,
+// so a load error or a lost route takes the queue offline again. Every change bumps the generation, so a retry timer
+// started before a newer failure or reachability change does nothing when it runs. All of these run on the main queue
+static SCNetworkReachabilityRef purchaseReachability = NULL;
+static bool purchaseReachable = false;
+static int purchaseOnlineGeneration = 0;
+
+static void setPurchaseOnline(bool online)
+{
+    purchaseOnlineGeneration++;
+    samcodeschartboost::setPurchaseTrackingOnline(online);
+}
+
+static bool isReachable(SCNetworkReachabilityFlags flags)
+{
+    return (flags & kSCNetworkReachabilityFlagsReachable) != 0 && (flags & kSCNetworkReachabilityFlagsConnectionRequired) == 0;
+}
+
+static void onReachabilityChanged(SCNetworkReachabilityRef target, SCNetworkReachabilityFlags flags, void* info)
+{
+    purchaseReachable = isReachable(flags);
+    setPurchaseOnline(purchaseReachable);
+}
+
+static void startReachabilityMonitor()
+{
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_len = sizeof(address);
+    address.sin_family = AF_INET;
+    purchaseReachability = SCNetworkReachabilityCreateWithAddress(kCFAllocatorDefault, (const struct sockaddr*)&address);
+    if(purchaseReachability == NULL) {
+        // With no reachability signal, purchases wait for the SDK to show it can reach its servers instead
+        return;
+    }
+    SCNetworkReachabilitySetCallback(purchaseReachability, onReachabilityChanged, NULL);
+    SCNetworkReachabilitySetDispatchQueue(purchaseReachability, dispatch_get_main_queue());
+    SCNetworkReachabilityFlags flags;
+    if(SCNetworkReachabilityGetFlags(purchaseReachability, &flags)) {
+        onReachabilityChanged(purchaseReachability, flags, NULL);
+    }
+}
+
+// Records a load error. Purchase tracking treats the device as offline after one of these until an ad caches,
+// reachability changes, or the retry timer runs out while the device still looks reachable
+static int handleLoadError(int error)
+{
+    int code = samcodeschartboost::recordError(samcodeschartboost::ERROR_DOMAIN_IMPRESSION, error);
+    if(code == samcodeschartboost::ERROR_INTERNET_UNAVAILABLE) {
+        setPurchaseOnline(false);
+        int generation = purchaseOnlineGeneration;
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(purchaseOnlineRetrySeconds * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+            if(generation == purchaseOnlineGeneration && (purchaseReachable || purchaseReachability == NULL)) {
+                setPurchaseOnline(true);
+            }
+        });
+    }
+    return code;
+}
+
+// A cached ad means the SDK just reached its servers
+static void handleAdCached()
+{
+    setPurchaseOnline(true);
+}
+
+static void advanceState(int type, NSString* location, int state)
+{
+    samcodeschartboost::advanceLocationState(type, [location UTF8String], state, samcodeschartboost::getMonotonicTime());
+}
+
+// Notes a cache request going to the SDK, so the placement selector can time it.
+// Rewarded videos have no shouldRequest callback, so this is also where their locations start requesting.
+// The SDK ignores requests for locations that are already cached, so those stay cached, keep the consent they were requested under
+// and don't start the selector's clock
+static void startCache(int type, NSString* location)
+{
+    int index = samcodeschartboost::internLocation([location UTF8String]);
+    if(samcodeschartboost::getLocationState(type, index) != samcodeschartboost::LOCATION_CACHED) {
+        samcodeschartboost::getSelector().onCacheRequested(type, [location UTF8String], samcodeschartboost::getMonotonicTime());
+        advanceState(type, location, samcodeschartboost::LOCATION_REQUESTING);
+        samcodeschartboost::noteConsentRequest(type, index);
+        samcodeschartboost::sampleMemory(samcodeschartboost::MEMORY_CACHE_START, type, [location UTF8String]);
+    }
+}
+
+// Lets the prefetch scheduler, predictor and placement selector know how a cache request turned out
+static void finishScheduledCache(int type, NSString* location, bool success, int code)
+{
+    double now = samcodeschartboost::getMonotonicTime();
+    samcodeschartboost::getScheduler().onCacheFinished(type, [location UTF8String], success, code, now);
+    samcodeschartboost::getPredictor().onCacheFinished(type, [location UTF8String], success, now);
+    samcodeschartboost::getSelector().onCacheFinished(type, [location UTF8String], success, now);
+}
+
 @interface MyChartboostDelegate : NSObject<ChartboostDelegate>
 @end
 
@@ -51,71 +283,105 @@ void dispatchEvent(NSString* type, NSString* location, NSString* uri, int reward
 // Called before requesting an interstitial via the Chartboost API server.
 - (BOOL)shouldRequestInterstitial:(CBLocation)location
 {
-    dispatchEvent(@"shouldRequestInterstitial", location, @"", 0, -1, false);
+    advanceState(samcodeschartboost::AD_TYPE_INTERSTITIAL, location, samcodeschartboost::LOCATION_REQUESTING);
+    samcodeschartboost::noteConsentRequest(samcodeschartboost::AD_TYPE_INTERSTITIAL, samcodeschartboost::internLocation([location UTF8String]));
+    dispatchEvent(samcodeschartboost::EVENT_SHOULD_REQUEST_INTERSTITIAL, location, @"", 0, -1, false);
     return YES;
 }
 
 // Called before an interstitial will be displayed on the screen.
+// Showing an ad is a natural pause point, so any buffered level tracking is sent now.
 - (BOOL)shouldDisplayInterstitial:(CBLocation)location
 {
-    dispatchEvent(@"shouldDisplayInterstitial", location, @"", 0, -1, false);
+    advanceState(samcodeschartboost::AD_TYPE_INTERSTITIAL, location, samcodeschartboost::LOCATION_SHOWING);
+    samcodeschartboost::sampleMemory(samcodeschartboost::MEMORY_SHOW_START, samcodeschartboost::AD_TYPE_INTERSTITIAL, [location UTF8String]);
+    samcodeschartboost::requestLevelInfoFlush();
+    dispatchEvent(samcodeschartboost::EVENT_SHOULD_DISPLAY_INTERSTITIAL, location, @"", 0, -1, false);
     return YES;
 }
 
 // Called after an interstitial has been displayed on the screen.
 - (void)didDisplayInterstitial:(CBLocation)location
 {
-    dispatchEvent(@"didDisplayInterstitial", location, @"", 0, -1, false);
+    advanceState(samcodeschartboost::AD_TYPE_INTERSTITIAL, location, samcodeschartboost::LOCATION_DISPLAYED);
+    updateAdSlots(samcodeschartboost::AD_TYPE_INTERSTITIAL, location, false);
+    samcodeschartboost::getPredictor().onShown(samcodeschartboost::AD_TYPE_INTERSTITIAL, [location UTF8String], samcodeschartboost::getMonotonicTime());
+    samcodeschartboost::onConsentPlacementDisplayed(samcodeschartboost::AD_TYPE_INTERSTITIAL, [location UTF8String], samcodeschartboost::getMonotonicTime());
+    dispatchEvent(samcodeschartboost::EVENT_DID_DISPLAY_INTERSTITIAL, location, @"", 0, -1, false);
 }
 
 // Called after an interstitial has been loaded from the Chartboost API
 // servers and cached locally.
 - (void)didCacheInterstitial:(CBLocation)location
 {
-    dispatchEvent(@"didCacheInterstitial", location, @"", 0, -1, false);
+    advanceState(samcodeschartboost::AD_TYPE_INTERSTITIAL, location, samcodeschartboost::LOCATION_CACHED);
+    updateAdSlots(samcodeschartboost::AD_TYPE_INTERSTITIAL, location, true);
+    handleAdCached();
+    finishScheduledCache(samcodeschartboost::AD_TYPE_INTERSTITIAL, location, true, samcodeschartboost::ERROR_UNKNOWN);
+    samcodeschartboost::markFirstCache(samcodeschartboost::AD_TYPE_INTERSTITIAL, [location UTF8String], samcodeschartboost::getMonotonicTime());
+    samcodeschartboost::sampleMemory(samcodeschartboost::MEMORY_DID_CACHE, samcodeschartboost::AD_TYPE_INTERSTITIAL, [location UTF8String]);
+    dispatchEvent(samcodeschartboost::EVENT_DID_CACHE_INTERSTITIAL, location, @"", 0, -1, false);
 }
 
 // Called after an interstitial has attempted to load from the Chartboost API
 // servers but failed.
 - (void)didFailToLoadInterstitial:(CBLocation)location withError:(CBLoadError)error
 {
-    dispatchEvent(@"didFailToLoadInterstitial", location, @"", 0, error, false);
+    advanceState(samcodeschartboost::AD_TYPE_INTERSTITIAL, location, samcodeschartboost::LOCATION_FAILED);
+    samcodeschartboost::cancelMemorySample(samcodeschartboost::MEMORY_CACHE_START, samcodeschartboost::AD_TYPE_INTERSTITIAL, [location UTF8String]);
+    updateAdSlots(samcodeschartboost::AD_TYPE_INTERSTITIAL, location, false);
+    finishScheduledCache(samcodeschartboost::AD_TYPE_INTERSTITIAL, location, false, handleLoadError(error));
+    dispatchEvent(samcodeschartboost::EVENT_DID_FAIL_TO_LOAD_INTERSTITIAL, location, @"", 0, error, false);
 }
 
 // Called after a click is registered, but the user is not forwarded to the App Store.
 - (void)didFailToRecordClick:(CBLocation)location withError:(CBClickError)error
 {
-    dispatchEvent(@"didFailToRecordClick", @"", @"", 0, error, false);
+    samcodeschartboost::recordError(samcodeschartboost::ERROR_DOMAIN_CLICK, error);
+    dispatchEvent(samcodeschartboost::EVENT_DID_FAIL_TO_RECORD_CLICK, @"", @"", 0, error, false);
 }
 
 // Called after an interstitial has been dismissed.
 - (void)didDismissInterstitial:(CBLocation)location
 {
-    dispatchEvent(@"didDismissInterstitial", location, @"", 0, -1, false);
+    advanceState(samcodeschartboost::AD_TYPE_INTERSTITIAL, location, samcodeschartboost::LOCATION_CLOSED);
+    dispatchEvent(samcodeschartboost::EVENT_DID_DISMISS_INTERSTITIAL, location, @"", 0, -1, false);
 }
 
 // Called after an interstitial has been closed.
 - (void)didCloseInterstitial:(CBLocation)location
 {
-    dispatchEvent(@"didCloseInterstitial", location, @"", 0, -1, false);
+    advanceState(samcodeschartboost::AD_TYPE_INTERSTITIAL, location, samcodeschartboost::LOCATION_CLOSED);
+    samcodeschartboost::sampleMemory(samcodeschartboost::MEMORY_DID_CLOSE, samcodeschartboost::AD_TYPE_INTERSTITIAL, [location UTF8String]);
+    dispatchEvent(samcodeschartboost::EVENT_DID_CLOSE_INTERSTITIAL, location, @"", 0, -1, false);
 }
 
 // Called after an interstitial has been clicked.
 - (void)didClickInterstitial:(CBLocation)location
 {
-    dispatchEvent(@"didClickInterstitial", location, @"", 0, -1, false);
+    dispatchEvent(samcodeschartboost::EVENT_DID_CLICK_INTERSTITIAL, location, @"", 0, -1, false);
 }
 
 // Called after the SDK has been successfully initialized.
 - (void)didInitialize:(BOOL)status
 {
-    dispatchEvent(@"didInitialize", @"", @"", 0, -1, status);
+    samcodeschartboost::markStartupMilestone(samcodeschartboost::STARTUP_DID_INITIALIZE, samcodeschartboost::getMonotonicTime());
+    samcodeschartboost::sampleMemory(samcodeschartboost::MEMORY_AFTER_INIT, -1, NULL);
+    if(status) {
+        setPurchaseOnline(true);
+    }
+    samcodeschartboost::setPurchaseTrackingReady(status);
+    dispatchEvent(samcodeschartboost::EVENT_DID_INITIALIZE, @"", @"", 0, -1, status);
 }
 
 // Called before a rewarded video will be displayed on the screen.
+// Showing an ad is a natural pause point, so any buffered level tracking is sent now.
 - (BOOL)shouldDisplayRewardedVideo:(CBLocation)location
 {
-    dispatchEvent(@"shouldDisplayRewardedVideo", location, @"", 0, -1, false);
+    advanceState(samcodeschartboost::AD_TYPE_REWARDED_VIDEO, location, samcodeschartboost::LOCATION_SHOWING);
+    samcodeschartboost::sampleMemory(samcodeschartboost::MEMORY_SHOW_START, samcodeschartboost::AD_TYPE_REWARDED_VIDEO, [location UTF8String]);
+    samcodeschartboost::requestLevelInfoFlush();
+    dispatchEvent(samcodeschartboost::EVENT_SHOULD_DISPLAY_REWARDED_VIDEO, location, @"", 0, -1, false);
     
     return YES;
 }
@@ -123,148 +389,421 @@ void dispatchEvent(NSString* type, NSString* location, NSString* uri, int reward
 // Called after a rewarded video has been displayed on the screen.
 - (void)didDisplayRewardedVideo:(CBLocation)location
 {
-    dispatchEvent(@"didDisplayRewardedVideo", location, @"", 0, -1, false);
+    advanceState(samcodeschartboost::AD_TYPE_REWARDED_VIDEO, location, samcodeschartboost::LOCATION_DISPLAYED);
+    updateAdSlots(samcodeschartboost::AD_TYPE_REWARDED_VIDEO, location, false);
+    samcodeschartboost::getPredictor().onShown(samcodeschartboost::AD_TYPE_REWARDED_VIDEO, [location UTF8String], samcodeschartboost::getMonotonicTime());
+    samcodeschartboost::onConsentPlacementDisplayed(samcodeschartboost::AD_TYPE_REWARDED_VIDEO, [location UTF8String], samcodeschartboost::getMonotonicTime());
+    dispatchEvent(samcodeschartboost::EVENT_DID_DISPLAY_REWARDED_VIDEO, location, @"", 0, -1, false);
 }
 
 // Called after a rewarded video has been loaded from the Chartboost API
 // servers and cached locally.
+// Rewarded videos have no shouldRequest callback, so a cache the SDK started on its own (again after a close, for one) was never
+// tied to a consent. It was fetched under the consent in force now, so it's tied to that here
 - (void)didCacheRewardedVideo:(CBLocation)location
 {
-    dispatchEvent(@"didCacheRewardedVideo", location, @"", 0, -1, false);
+    int index = samcodeschartboost::internLocation([location UTF8String]);
+    if(samcodeschartboost::getLocationState(samcodeschartboost::AD_TYPE_REWARDED_VIDEO, index) != samcodeschartboost::LOCATION_REQUESTING) {
+        samcodeschartboost::noteConsentRequest(samcodeschartboost::AD_TYPE_REWARDED_VIDEO, index);
+    }
+    advanceState(samcodeschartboost::AD_TYPE_REWARDED_VIDEO, location, samcodeschartboost::LOCATION_CACHED);
+    updateAdSlots(samcodeschartboost::AD_TYPE_REWARDED_VIDEO, location, true);
+    handleAdCached();
+    finishScheduledCache(samcodeschartboost::AD_TYPE_REWARDED_VIDEO, location, true, samcodeschartboost::ERROR_UNKNOWN);
+    samcodeschartboost::markFirstCache(samcodeschartboost::AD_TYPE_REWARDED_VIDEO, [location UTF8String], samcodeschartboost::getMonotonicTime());
+    samcodeschartboost::sampleMemory(samcodeschartboost::MEMORY_DID_CACHE, samcodeschartboost::AD_TYPE_REWARDED_VIDEO, [location UTF8String]);
+    dispatchEvent(samcodeschartboost::EVENT_DID_CACHE_REWARDED_VIDEO, location, @"", 0, -1, false);
 }
 
 // Called after a rewarded video has attempted to load from the Chartboost API
 // servers but failed.
 - (void)didFailToLoadRewardedVideo:(CBLocation)location withError:(CBLoadError)error
 {
-    dispatchEvent(@"didFailToLoadRewardedVideo", location, @"", 0, error, false);
+    advanceState(samcodeschartboost::AD_TYPE_REWARDED_VIDEO, location, samcodeschartboost::LOCATION_FAILED);
+    samcodeschartboost::cancelMemorySample(samcodeschartboost::MEMORY_CACHE_START, samcodeschartboost::AD_TYPE_REWARDED_VIDEO, [location UTF8String]);
+    updateAdSlots(samcodeschartboost::AD_TYPE_REWARDED_VIDEO, location, false);
+    finishScheduledCache(samcodeschartboost::AD_TYPE_REWARDED_VIDEO, location, false, handleLoadError(error));
+    dispatchEvent(samcodeschartboost::EVENT_DID_FAIL_TO_LOAD_REWARDED_VIDEO, location, @"", 0, error, false);
 }
 
 // Called after a rewarded video has been dismissed.
 - (void)didDismissRewardedVideo:(CBLocation)location
 {
-    dispatchEvent(@"didDismissRewardedVideo", location, @"", 0, -1, false);
+    advanceState(samcodeschartboost::AD_TYPE_REWARDED_VIDEO, location, samcodeschartboost::LOCATION_CLOSED);
+    dispatchEvent(samcodeschartboost::EVENT_DID_DISMISS_REWARDED_VIDEO, location, @"", 0, -1, false);
 }
 
 // Called after a rewarded video has been closed.
 - (void)didCloseRewardedVideo:(CBLocation)location
 {
-    dispatchEvent(@"didCloseRewardedVideo", location, @"", 0, -1, false);
+    advanceState(samcodeschartboost::AD_TYPE_REWARDED_VIDEO, location, samcodeschartboost::LOCATION_CLOSED);
+    samcodeschartboost::sampleMemory(samcodeschartboost::MEMORY_DID_CLOSE, samcodeschartboost::AD_TYPE_REWARDED_VIDEO, [location UTF8String]);
+    dispatchEvent(samcodeschartboost::EVENT_DID_CLOSE_REWARDED_VIDEO, location, @"", 0, -1, false);
 }
 
 // Called after a rewarded video has been clicked.
 - (void)didClickRewardedVideo:(CBLocation)location
 {
-    dispatchEvent(@"didClickRewardedVideo", location, @"", 0, -1, false);
+    dispatchEvent(samcodeschartboost::EVENT_DID_CLICK_REWARDED_VIDEO, location, @"", 0, -1, false);
 }
 
 // Called after a rewarded video has been viewed completely and user is eligible for reward.
 - (void)didCompleteRewardedVideo:(CBLocation)location withReward:(int)reward
 {
-    dispatchEvent(@"didCompleteRewardedVideo", location, @"", reward, -1, false);
+    dispatchEvent(samcodeschartboost::EVENT_DID_COMPLETE_REWARDED_VIDEO, location, @"", reward, -1, false);
 }
 
 // Implement to be notified of when a video will be displayed on the screen for
 // a given CBLocation. You can then do things like mute effects and sounds.
 - (void)willDisplayVideo:(CBLocation)location
 {
-    dispatchEvent(@"willDisplayVideo", location, @"", 0, -1, false);
+    dispatchEvent(samcodeschartboost::EVENT_WILL_DISPLAY_VIDEO, location, @"", 0, -1, false);
+}
+
+@end
+
+// A banner in the native pool. Released banners stay in the view hierarchy (hidden) so they can be handed out again
+// for the same size and location without creating a new view
+struct BannerSlot
+{
+    CHBBanner* banner;
+    int size;
+    int generation;
+    bool inUse;
+    bool visible;
+    bool shown;
+    bool refreshPending;
+    double refreshInterval;
+    double sinceRefresh;
+};
+
+static std::vector<BannerSlot> bannerSlots;
+
+// Hands a slot to a new owner with the default refresh settings, whatever the previous owner left them at.
+// A pooled banner keeps whether it has been shown, so its creative can be reused
+static void resetBannerSlot(BannerSlot& slot)
+{
+    slot.inUse = true;
+    slot.visible = false;
+    slot.refreshPending = false;
+    slot.refreshInterval = 30.0;
+    slot.sinceRefresh = 0.0;
+}
+
+static UIViewController* getRootViewController()
+{
+    return [[[UIApplication sharedApplication] keyWindow] rootViewController];
+}
+
+static BannerSlot* getBannerSlot(int handle)
+{
+    int index = getHandleIndex(handle);
+    if(index < 0 || index >= (int)bannerSlots.size()) {
+        return NULL;
+    }
+    BannerSlot* slot = &bannerSlots[index];
+    if(!slot->inUse || slot->generation != getHandleGeneration(handle)) {
+        return NULL;
+    }
+    return slot;
+}
+
+static BannerSlot* findBannerSlot(id<CHBAd> ad)
+{
+    for(size_t i = 0; i < bannerSlots.size(); i++) {
+        if(bannerSlots[i].banner == ad) {
+            return &bannerSlots[i];
+        }
+    }
+    return NULL;
+}
+
+static CGSize getBannerSize(int size)
+{
+    switch(size) {
+        case 1:
+            return CHBBannerSizeMedium;
+        case 2:
+            return CHBBannerSizeLeaderboard;
+        default:
+            return CHBBannerSizeStandard;
+    }
+}
+
+@interface MyChartboostBannerDelegate : NSObject<CHBBannerDelegate>
+@end
+
+@implementation MyChartboostBannerDelegate
+
+// Called when a banner cache request finishes. Refreshes issued by updateBanners are only swapped in when the banner is still visible
+- (void)didCacheAd:(CHBCacheEvent *)event error:(CHBCacheError *)error
+{
+    BannerSlot* slot = findBannerSlot(event.ad);
+    if(slot != NULL && slot->refreshPending) {
+        slot->refreshPending = false;
+        if(error == nil && slot->inUse && slot->visible) {
+            SCB_TIME_SDK_CALL("CHBBanner.showFromViewController", [slot->banner.location UTF8String]);
+            [slot->banner showFromViewController:getRootViewController()];
+        }
+    }
+    if(error != nil) {
+        handleLoadError((int)error.code);
+    } else {
+        handleAdCached();
+    }
+    dispatchEvent(samcodeschartboost::EVENT_DID_CACHE_BANNER, event.ad.location, @"", 0, error != nil ? (int)error.code : -1, false);
+}
+
+// Called right before a banner is presented
+- (void)willShowAd:(CHBShowEvent *)event error:(CHBShowError *)error
+{
+    dispatchEvent(samcodeschartboost::EVENT_WILL_SHOW_BANNER, event.ad.location, @"", 0, error != nil ? (int)error.code : -1, false);
+}
+
+// Called after a banner has been presented, or failed to present. Show errors are counted here rather than in willShowAd, so they're only counted once
+- (void)didShowAd:(CHBShowEvent *)event error:(CHBShowError *)error
+{
+    if(error != nil) {
+        samcodeschartboost::recordError(samcodeschartboost::ERROR_DOMAIN_IMPRESSION, (int)error.code);
+    }
+    dispatchEvent(samcodeschartboost::EVENT_DID_SHOW_BANNER, event.ad.location, @"", 0, error != nil ? (int)error.code : -1, false);
+}
+
+// Called after a banner has been clicked
+- (void)didClickAd:(CHBClickEvent *)event error:(CHBClickError *)error
+{
+    if(error != nil) {
+        samcodeschartboost::recordError(samcodeschartboost::ERROR_DOMAIN_CLICK, (int)error.code);
+    }
+    dispatchEvent(samcodeschartboost::EVENT_DID_CLICK_BANNER, event.ad.location, @"", 0, error != nil ? (int)error.code : -1, false);
 }
 
 @end
 
+static MyChartboostBannerDelegate* bannerDelegate = nil;
+
+// A native ad object. The icon is kept here so Haxe can view its bytes in place, and the decoded pixels live here
+// until the slot is released
+struct InPlaySlot
+{
+    CBInPlay* inPlay;
+    NSData* icon;
+    unsigned char* pixels;
+    int width;
+    int height;
+    int generation;
+    bool inUse;
+    bool decodeStarted;
+};
+
+static std::vector<InPlaySlot> inPlaySlots;
+
+static InPlaySlot* getInPlaySlot(int handle)
+{
+    int index = getHandleIndex(handle);
+    if(index < 0 || index >= (int)inPlaySlots.size()) {
+        return NULL;
+    }
+    InPlaySlot* slot = &inPlaySlots[index];
+    if(!slot->inUse || slot->generation != getHandleGeneration(handle)) {
+        return NULL;
+    }
+    return slot;
+}
+
+// Decodes an image into premultiplied RGBA, 8 bits per channel, rows top to bottom. Returns NULL on failure
+static unsigned char* decodeImageToRGBA(NSData* data, int* width, int* height)
+{
+    UIImage* image = [UIImage imageWithData:data];
+    CGImageRef cgImage = image.CGImage;
+    if(cgImage == NULL) {
+        return NULL;
+    }
+    
+    size_t w = CGImageGetWidth(cgImage);
+    size_t h = CGImageGetHeight(cgImage);
+    unsigned char* pixels = (unsigned char*)calloc(w * h * 4, 1);
+    if(pixels == NULL) {
+        return NULL;
+    }
+    
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(pixels, w, h, 8, w * 4, colorSpace, kCGImageAlphaPremultipliedLast | kCGBitmapByteOrder32Big);
+    CGColorSpaceRelease(colorSpace);
+    if(context == NULL) {
+        free(pixels);
+        return NULL;
+    }
+    CGContextDrawImage(context, CGRectMake(0, 0, w, h), cgImage);
+    CGContextRelease(context);
+    
+    *width = (int)w;
+    *height = (int)h;
+    return pixels;
+}
+
+// Parses a price that may be formatted for display, such as "$0.99", "0,99 €" or "1.299,00". Everything but digits and separators
+// is ignored, and the last '.' or ',' is the decimal separator if one or two digits follow it, any others group thousands.
+// Returns nil if there are no digits
+static NSDecimalNumber* parsePrice(const char* price)
+{
+    const char* decimal = NULL;
+    for(const char* c = price; *c != '\0'; c++) {
+        if(*c == '.' || *c == ',') {
+            decimal = c;
+        }
+    }
+    if(decimal != NULL) {
+        int digits = 0;
+        for(const char* c = decimal + 1; *c != '\0'; c++) {
+            if(isdigit((unsigned char)*c)) {
+                digits++;
+            }
+        }
+        if(digits < 1 || digits > 2) {
+            decimal = NULL;
+        }
+    }
+    
+    std::string normalized;
+    bool hasDigits = false;
+    for(const char* c = price; *c != '\0'; c++) {
+        if(isdigit((unsigned char)*c)) {
+            normalized.push_back(*c);
+            hasDigits = true;
+        } else if(c == decimal) {
+            normalized.push_back('.');
+        }
+    }
+    if(!hasDigits) {
+        return nil;
+    }
+    
+    NSLocale* posix = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+    NSDecimalNumber* number = [NSDecimalNumber decimalNumberWithString:[NSString stringWithUTF8String:normalized.c_str()] locale:posix];
+    if(number == nil || [number isEqualToNumber:[NSDecimalNumber notANumber]]) {
+        return nil;
+    }
+    return number;
+}
+
 namespace samcodeschartboost
 {
     void initChartboost(const char* appId, const char* appSignature)
     {
+        samcodeschartboost::markStartupMilestone(samcodeschartboost::STARTUP_INIT_ENTER, samcodeschartboost::getMonotonicTime());
         static dispatch_once_t once;
         dispatch_once(&once, ^ {
             MyChartboostDelegate *myObject = [MyChartboostDelegate new];
             
-            NSString* nsAppId = [NSString stringWithUTF8String:appId];
-            NSString* nsSignature = [NSString stringWithUTF8String:appSignature];
+            // The SDK expects consent before it starts, the persisted value is sent without asking the SDK for its own
+            samcodeschartboost::applyPersistedConsent();
+            samcodeschartboost::sampleMemory(samcodeschartboost::MEMORY_BEFORE_INIT, -1, NULL);
+            startReachabilityMonitor();
             
+            NSString* nsAppId = makeNSString(appId);
+            NSString* nsSignature = makeNSString(appSignature);
+            
+            SCB_TIME_SDK_CALL("startWithAppId", NULL);
             [Chartboost startWithAppId:nsAppId
                           appSignature:nsSignature
                               delegate:myObject];
+            samcodeschartboost::markStartupMilestone(samcodeschartboost::STARTUP_SDK_STARTED, samcodeschartboost::getMonotonicTime());
         });
+        samcodeschartboost::markStartupMilestone(samcodeschartboost::STARTUP_INIT_EXIT, samcodeschartboost::getMonotonicTime());
     }
     
     void showInterstitial(const char* location)
     {
-        NSString* nsLocation = [NSString stringWithUTF8String:location];
+        NSString* nsLocation = makeNSString(location);
+        SCB_TIME_SDK_CALL("showInterstitial", location);
         [Chartboost showInterstitial:nsLocation];
     }
     
     void cacheInterstitial(const char* location)
     {
-        NSString* nsLocation = [NSString stringWithUTF8String:location];
+        NSString* nsLocation = makeNSString(location);
+        startCache(AD_TYPE_INTERSTITIAL, nsLocation);
+        SCB_TIME_SDK_CALL("cacheInterstitial", location);
         [Chartboost cacheInterstitial:nsLocation];
     }
     
     bool hasInterstitial(const char* location)
     {
-        NSString* nsLocation = [NSString stringWithUTF8String:location];
+        NSString* nsLocation = makeNSString(location);
+        SCB_TIME_SDK_CALL("hasInterstitial", location);
         return [Chartboost hasInterstitial:nsLocation];
     }
     
     void showRewardedVideo(const char* location)
     {
-        NSString* nsLocation = [NSString stringWithUTF8String:location];
+        NSString* nsLocation = makeNSString(location);
+        SCB_TIME_SDK_CALL("showRewardedVideo", location);
         [Chartboost showRewardedVideo:nsLocation];
     }
     
     void cacheRewardedVideo(const char* location)
     {
-        NSString* nsLocation = [NSString stringWithUTF8String:location];
+        NSString* nsLocation = makeNSString(location);
+        startCache(AD_TYPE_REWARDED_VIDEO, nsLocation);
+        SCB_TIME_SDK_CALL("cacheRewardedVideo", location);
         [Chartboost cacheRewardedVideo:nsLocation];
     }
     
     bool hasRewardedVideo(const char* location)
     {
-        NSString* nsLocation = [NSString stringWithUTF8String:location];
+        NSString* nsLocation = makeNSString(location);
+        SCB_TIME_SDK_CALL("hasRewardedVideo", location);
         return [Chartboost hasRewardedVideo:nsLocation];
     }
     
     bool isAnyViewVisible()
     {
+        SCB_TIME_SDK_CALL("isAnyViewVisible", NULL);
         return [Chartboost isAnyViewVisible];
     }
     
     void setCustomId(const char* id)
     {
-        NSString* nsId = [NSString stringWithUTF8String:id];
+        NSString* nsId = makeNSString(id);
+        SCB_TIME_SDK_CALL("setCustomId", NULL);
         [Chartboost setCustomId:nsId];
     }
     
     const char* getCustomId()
     {
+        SCB_TIME_SDK_CALL("getCustomId", NULL);
         NSString* nsId = [Chartboost getCustomId];
         return [nsId UTF8String];
     }
     
     void setShouldRequestInterstitialsInFirstSession(bool shouldRequest)
     {
+        SCB_TIME_SDK_CALL("setShouldRequestInterstitialsInFirstSession", NULL);
         [Chartboost setShouldRequestInterstitialsInFirstSession:shouldRequest];
     }
     
     bool getAutoCacheAds()
     {
+        SCB_TIME_SDK_CALL("getAutoCacheAds", NULL);
         return [Chartboost getAutoCacheAds];
     }
     
     void setAutoCacheAds(bool autoCache)
     {
+        SCB_TIME_SDK_CALL("setAutoCacheAds", NULL);
         [Chartboost setAutoCacheAds:autoCache];
     }
     
     void setShouldPrefetchVideoContent(bool shouldPrefetch)
     {
+        SCB_TIME_SDK_CALL("setShouldPrefetchVideoContent", NULL);
         [Chartboost setShouldPrefetchVideoContent:shouldPrefetch];
     }
     
     const char* getSDKVersion()
     {
+        SCB_TIME_SDK_CALL("getSDKVersion", NULL);
         NSString* nsVersion = [Chartboost getSDKVersion];
         return [nsVersion UTF8String];
     }
@@ -272,24 +811,29 @@ namespace samcodeschartboost
     void setStatusBarBehavior(bool shouldHide)
     {
         if(shouldHide) {
+            SCB_TIME_SDK_CALL("setStatusBarBehavior", NULL);
             [Chartboost setStatusBarBehavior:CBStatusBarBehaviorIgnore];
         } else {
+            SCB_TIME_SDK_CALL("setStatusBarBehavior", NULL);
             [Chartboost setStatusBarBehavior:CBStatusBarBehaviorRespect];
         }
     }
     
     void setMuted(bool mute)
     {
+        SCB_TIME_SDK_CALL("setMuted", NULL);
         [Chartboost setMuted:mute];
     }
     
     void restrictDataCollection(bool shouldRestrict)
     {
+        SCB_TIME_SDK_CALL("restrictDataCollection", NULL);
         [Chartboost restrictDataCollection:shouldRestrict];
     }
     
     int getPIDataUseConsent()
     {
+        SCB_TIME_SDK_CALL("getPIDataUseConsent", NULL);
         CBPIDataUseConsent currentConsent = [Chartboost getPIDataUseConsent];
         return (int)(currentConsent);
     }
@@ -297,6 +841,486 @@ namespace samcodeschartboost
     void setPIDataUseConsent(int consent)
     {
         CBPIDataUseConsent consentEnum = (CBPIDataUseConsent)(consent);
+        SCB_TIME_SDK_CALL("setPIDataUseConsent", NULL);
         [Chartboost setPIDataUseConsent:consent];
     }
-}
+    
+    int acquireBanner(const char* location, int size)
+    {
+        NSString* nsLocation = makeNSString(location);
+        
+        // Prefer a pooled banner that was already created for this size and location
+        int freeIndex = -1;
+        for(size_t i = 0; i < bannerSlots.size(); i++) {
+            BannerSlot& slot = bannerSlots[i];
+            if(slot.inUse) {
+                continue;
+            }
+            if(slot.banner == nil) {
+                if(freeIndex < 0) {
+                    freeIndex = (int)i;
+                }
+                continue;
+            }
+            if(slot.size == size && [slot.banner.location isEqualToString:nsLocation]) {
+                slot.generation = (slot.generation + 1) & 0x7FFF;
+                resetBannerSlot(slot);
+                return makeHandle((int)i, slot.generation);
+            }
+        }
+        
+        if(freeIndex < 0) {
+            if(bannerSlots.size() >= 0xFFFF) {
+                return 0;
+            }
+            BannerSlot empty = {};
+            bannerSlots.push_back(empty);
+            freeIndex = (int)(bannerSlots.size() - 1);
+        }
+        
+        if(bannerDelegate == nil) {
+            bannerDelegate = [MyChartboostBannerDelegate new];
+        }
+        
+        // The SDK's own refresh timer is disabled, refreshes are driven from updateBanners instead
+        CHBBanner* banner = nil;
+        {
+            SCB_TIME_SDK_CALL("CHBBanner.initWithSize", location);
+            banner = [[CHBBanner alloc] initWithSize:getBannerSize(size) location:nsLocation delegate:bannerDelegate];
+        }
+        banner.automaticallyRefreshesContent = NO;
+        banner.hidden = YES;
+        [getRootViewController().view addSubview:banner];
+        
+        BannerSlot& slot = bannerSlots[freeIndex];
+        slot.banner = banner;
+        slot.size = size;
+        slot.generation = (slot.generation + 1) & 0x7FFF;
+        slot.shown = false;
+        resetBannerSlot(slot);
+        
+        return makeHandle(freeIndex, slot.generation);
+    }
+    
+    void releaseBanner(int handle)
+    {
+        BannerSlot* slot = getBannerSlot(handle);
+        if(slot == NULL) {
+            return;
+        }
+        slot->banner.hidden = YES;
+        slot->inUse = false;
+        slot->visible = false;
+        slot->sinceRefresh = 0.0;
+    }
+    
+    void showBanner(int handle)
+    {
+        BannerSlot* slot = getBannerSlot(handle);
+        if(slot == NULL) {
+            return;
+        }
+        slot->visible = true;
+        slot->banner.hidden = NO;
+        
+        // A reused banner keeps the creative it had, so only the first show goes to the SDK
+        if(!slot->shown) {
+            slot->shown = true;
+            SCB_TIME_SDK_CALL("CHBBanner.showFromViewController", [slot->banner.location UTF8String]);
+            [slot->banner showFromViewController:getRootViewController()];
+        }
+    }
+    
+    void hideBanner(int handle)
+    {
+        BannerSlot* slot = getBannerSlot(handle);
+        if(slot == NULL) {
+            return;
+        }
+        slot->visible = false;
+        slot->banner.hidden = YES;
+    }
+    
+    void setBannerPosition(int handle, double x, double y)
+    {
+        BannerSlot* slot = getBannerSlot(handle);
+        if(slot == NULL) {
+            return;
+        }
+        CGSize size = getBannerSize(slot->size);
+        slot->banner.frame = CGRectMake(x, y, size.width, size.height);
+    }
+    
+    void setBannerRefreshInterval(int handle, double seconds)
+    {
+        BannerSlot* slot = getBannerSlot(handle);
+        if(slot == NULL) {
+            return;
+        }
+        slot->refreshInterval = seconds;
+    }
+    
+    bool isBannerCached(int handle)
+    {
+        BannerSlot* slot = getBannerSlot(handle);
+        if(slot == NULL) {
+            return false;
+        }
+        return slot->banner.isCached;
+    }
+    
+    void updateBanners(double dt, bool frameBudgetTight)
+    {
+        for(size_t i = 0; i < bannerSlots.size(); i++) {
+            BannerSlot& slot = bannerSlots[i];
+            if(!slot.inUse || !slot.visible || !slot.shown || slot.refreshInterval <= 0.0) {
+                continue;
+            }
+            
+            slot.sinceRefresh += dt;
+            
+            // Refreshes wait while the frame budget is tight, the banner just keeps its current creative a little longer
+            if(frameBudgetTight || slot.refreshPending || slot.sinceRefresh < slot.refreshInterval) {
+                continue;
+            }
+            
+            slot.sinceRefresh = 0.0;
+            slot.refreshPending = true;
+            SCB_TIME_SDK_CALL("CHBBanner.cache", [slot.banner.location UTF8String]);
+            [slot.banner cache];
+        }
+    }
+    
+    void drainBannerPool()
+    {
+        // Slots are emptied rather than erased so the handles of banners still in use stay valid
+        for(size_t i = 0; i < bannerSlots.size(); i++) {
+            BannerSlot& slot = bannerSlots[i];
+            if(slot.inUse || slot.banner == nil) {
+                continue;
+            }
+            [slot.banner removeFromSuperview];
+            SCB_RELEASE(slot.banner);
+            slot.banner = nil;
+        }
+    }
+    
+    int createAd(int type, const char* location)
+    {
+        if(type != AD_TYPE_INTERSTITIAL && type != AD_TYPE_REWARDED_VIDEO) {
+            return 0;
+        }
+        
+        int index = -1;
+        for(size_t i = 0; i < adSlots.size(); i++) {
+            if(!adSlots[i].inUse) {
+                index = (int)i;
+                break;
+            }
+        }
+        if(index < 0) {
+            if(adSlots.size() >= 0xFFFF) {
+                return 0;
+            }
+            AdSlot empty = {};
+            adSlots.push_back(empty);
+            index = (int)(adSlots.size() - 1);
+        }
+        
+        AdSlot& slot = adSlots[index];
+        SCB_AUDIT_ALLOCATION(samcodeschartboost::ALLOCATION_NATIVE, strlen(location) + 1);
+        slot.location = [[NSString alloc] initWithUTF8String:location];
+        slot.type = type;
+        slot.generation = (slot.generation + 1) & 0x7FFF;
+        slot.inUse = true;
+        slot.requested = false;
+        
+        // Picks up anything the SDK already has cached for the location, after this the delegate keeps the slot up to date
+        if(type == AD_TYPE_INTERSTITIAL) {
+            SCB_TIME_SDK_CALL("hasInterstitial", [slot.location UTF8String]);
+            slot.cached = [Chartboost hasInterstitial:slot.location];
+        } else {
+            SCB_TIME_SDK_CALL("hasRewardedVideo", [slot.location UTF8String]);
+            slot.cached = [Chartboost hasRewardedVideo:slot.location];
+        }
+        
+        return makeHandle(index, slot.generation);
+    }
+    
+    void releaseAd(int handle)
+    {
+        AdSlot* slot = getAdSlot(handle);
+        if(slot == NULL) {
+            return;
+        }
+        SCB_RELEASE(slot->location);
+        slot->location = nil;
+        slot->inUse = false;
+    }
+    
+    void cacheAd(int handle)
+    {
+        AdSlot* slot = getAdSlot(handle);
+        if(slot == NULL || slot->cached) {
+            return;
+        }
+        double now = samcodeschartboost::getMonotonicTime();
+        if(slot->requested && now - slot->requestedAt < samcodeschartboost::getScheduler().getPolicy().requestTimeout) {
+            return;
+        }
+        slot->requested = true;
+        slot->requestedAt = now;
+        startCache(slot->type, slot->location);
+        if(slot->type == AD_TYPE_INTERSTITIAL) {
+            SCB_TIME_SDK_CALL("cacheInterstitial", [slot->location UTF8String]);
+            [Chartboost cacheInterstitial:slot->location];
+        } else {
+            SCB_TIME_SDK_CALL("cacheRewardedVideo", [slot->location UTF8String]);
+            [Chartboost cacheRewardedVideo:slot->location];
+        }
+    }
+    
+    void showAd(int handle)
+    {
+        AdSlot* slot = getAdSlot(handle);
+        if(slot == NULL) {
+            return;
+        }
+        if(slot->type == AD_TYPE_INTERSTITIAL) {
+            SCB_TIME_SDK_CALL("showInterstitial", [slot->location UTF8String]);
+            [Chartboost showInterstitial:slot->location];
+        } else {
+            SCB_TIME_SDK_CALL("showRewardedVideo", [slot->location UTF8String]);
+            [Chartboost showRewardedVideo:slot->location];
+        }
+    }
+    
+    bool isAdCached(int handle)
+    {
+        AdSlot* slot = getAdSlot(handle);
+        return slot != NULL && slot->cached;
+    }
+    
+    void sendLevelInfo(const char* label, int levelType, int mainLevel, int subLevel, const char* description)
+    {
+        NSString* nsLabel = makeNSString(label);
+        NSString* nsDescription = makeNSString(description);
+        SCB_TIME_SDK_CALL("CBAnalytics.trackLevelInfo", NULL);
+        [CBAnalytics trackLevelInfo:nsLabel eventField:(CBLevelType)levelType mainLevel:mainLevel subLevel:subLevel description:nsDescription];
+    }
+    
+    void scheduleLevelInfoFlush(double delaySeconds)
+    {
+        static dispatch_queue_t analyticsQueue = dispatch_queue_create("samcodeschartboost.analytics", DISPATCH_QUEUE_SERIAL);
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delaySeconds * NSEC_PER_SEC)), analyticsQueue, ^{
+            @autoreleasepool {
+                flushLevelInfo();
+            }
+        });
+    }
+    
+    bool sendPurchase(const char* receiptBase64, const char* title, const char* description, const char* price, const char* currency, const char* productId)
+    {
+        @autoreleasepool {
+            NSDecimalNumber* productPrice = parsePrice(price);
+            if(productPrice == nil) {
+                NSLog(@"Dropping Chartboost purchase of %s, could not parse its price: [%s]", productId, price);
+                return false;
+            }
+            SCB_TIME_SDK_CALL("CBAnalytics.trackInAppPurchaseEventWithString", NULL);
+            [CBAnalytics trackInAppPurchaseEventWithString:makeNSString(receiptBase64)
+                                              productTitle:makeNSString(title)
+                                        productDescription:makeNSString(description)
+                                              productPrice:productPrice
+                                           productCurrency:makeNSString(currency)
+                                         productIdentifier:makeNSString(productId)];
+            return true;
+        }
+    }
+    
+    std::string getStoragePath(const char* fileName)
+    {
+        NSString* directory = [NSSearchPathForDirectoriesInDomains(NSLibraryDirectory, NSUserDomainMask, YES) firstObject];
+        NSString* path = [directory stringByAppendingPathComponent:makeNSString(fileName)];
+        return std::string([path fileSystemRepresentation]);
+    }
+    
+    void cacheInPlay(const char* location)
+    {
+        NSString* nsLocation = makeNSString(location);
+        SCB_TIME_SDK_CALL("cacheInPlay", location);
+        [Chartboost cacheInPlay:nsLocation];
+    }
+    
+    bool hasInPlay(const char* location)
+    {
+        NSString* nsLocation = makeNSString(location);
+        SCB_TIME_SDK_CALL("hasInPlay", location);
+        return [Chartboost hasInPlay:nsLocation];
+    }
+    
+    int getInPlay(const char* location)
+    {
+        NSString* nsLocation = makeNSString(location);
+        SCB_TIME_SDK_CALL("getInPlay", location);
+        CBInPlay* inPlay = [Chartboost getInPlay:nsLocation];
+        if(inPlay == nil) {
+            return 0;
+        }
+        
+        int index = -1;
+        for(size_t i = 0; i < inPlaySlots.size(); i++) {
+            if(!inPlaySlots[i].inUse) {
+                index = (int)i;
+                break;
+            }
+        }
+        if(index < 0) {
+            if(inPlaySlots.size() >= 0xFFFF) {
+                return 0;
+            }
+            InPlaySlot empty = {};
+            inPlaySlots.push_back(empty);
+            index = (int)(inPlaySlots.size() - 1);
+        }
+        
+        InPlaySlot& slot = inPlaySlots[index];
+        slot.inPlay = SCB_RETAIN(inPlay);
+        slot.icon = SCB_RETAIN(inPlay.appIcon);
+        slot.pixels = NULL;
+        slot.width = 0;
+        slot.height = 0;
+        slot.generation = (slot.generation + 1) & 0x7FFF;
+        slot.inUse = true;
+        slot.decodeStarted = false;
+        
+        return makeHandle(index, slot.generation);
+    }
+    
+    void releaseInPlay(int handle)
+    {
+        InPlaySlot* slot = getInPlaySlot(handle);
+        if(slot == NULL) {
+            return;
+        }
+        SCB_RELEASE(slot->inPlay);
+        SCB_RELEASE(slot->icon);
+        slot->inPlay = nil;
+        slot->icon = nil;
+        free(slot->pixels);
+        slot->pixels = NULL;
+        slot->inUse = false;
+    }
+    
+    const char* getInPlayAppName(int handle)
+    {
+        InPlaySlot* slot = getInPlaySlot(handle);
+        if(slot == NULL || slot->inPlay.appName == nil) {
+            return "";
+        }
+        return [slot->inPlay.appName UTF8String];
+    }
+    
+    const unsigned char* getInPlayIconData(int handle)
+    {
+        InPlaySlot* slot = getInPlaySlot(handle);
+        if(slot == NULL || slot->icon == nil) {
+            return NULL;
+        }
+        return (const unsigned char*)[slot->icon bytes];
+    }
+    
+    int getInPlayIconLength(int handle)
+    {
+        InPlaySlot* slot = getInPlaySlot(handle);
+        if(slot == NULL || slot->icon == nil) {
+            return 0;
+        }
+        return (int)[slot->icon length];
+    }
+    
+    void decodeInPlayIcon(int handle)
+    {
+        InPlaySlot* slot = getInPlaySlot(handle);
+        if(slot == NULL || slot->icon == nil || slot->decodeStarted) {
+            return;
+        }
+        slot->decodeStarted = true;
+        
+        // The block keeps the icon data alive while decoding, the result is handed back on the main queue and dropped
+        // if the handle was released in the meantime
+        NSData* icon = slot->icon;
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0), ^{
+            int width = 0;
+            int height = 0;
+            unsigned char* pixels = NULL;
+            @autoreleasepool {
+                pixels = decodeImageToRGBA(icon, &width, &height);
+            }
+            dispatch_async(dispatch_get_main_queue(), ^{
+                InPlaySlot* decodedSlot = getInPlaySlot(handle);
+                if(decodedSlot == NULL) {
+                    free(pixels);
+                    return;
+                }
+                decodedSlot->pixels = pixels;
+                decodedSlot->width = width;
+                decodedSlot->height = height;
+            });
+        });
+    }
+    
+    bool isInPlayIconDecoded(int handle)
+    {
+        InPlaySlot* slot = getInPlaySlot(handle);
+        return slot != NULL && slot->pixels != NULL;
+    }
+    
+    const unsigned char* getInPlayIconPixels(int handle)
+    {
+        InPlaySlot* slot = getInPlaySlot(handle);
+        if(slot == NULL) {
+            return NULL;
+        }
+        return slot->pixels;
+    }
+    
+    int getInPlayIconWidth(int handle)
+    {
+        InPlaySlot* slot = getInPlaySlot(handle);
+        return slot != NULL ? slot->width : 0;
+    }
+    
+    int getInPlayIconHeight(int handle)
+    {
+        InPlaySlot* slot = getInPlaySlot(handle);
+        return slot != NULL ? slot->height : 0;
+    }
+    
+    void showInPlay(int handle)
+    {
+        InPlaySlot* slot = getInPlaySlot(handle);
+        if(slot != NULL) {
+            SCB_TIME_SDK_CALL("CBInPlay.show", NULL);
+            [slot->inPlay show];
+        }
+    }
+    
+    void clickInPlay(int handle)
+    {
+        InPlaySlot* slot = getInPlaySlot(handle);
+        if(slot != NULL) {
+            SCB_TIME_SDK_CALL("CBInPlay.click", NULL);
+            [slot->inPlay click];
+        }
+    }
+    
+    void clearInPlayCache(int handle)
+    {
+        InPlaySlot* slot = getInPlaySlot(handle);
+        if(slot != NULL) {
+            SCB_TIME_SDK_CALL("CBInPlay.clearCache", NULL);
+            [slot->inPlay clearCache];
+        }
+    }
+}
\ No newline at end of file
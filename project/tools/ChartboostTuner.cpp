@@ -0,0 +1,475 @@
+// Replays recorded sessions against a grid of scheduler policies, using the simulated SDK on a virtual clock,
+// and reports availability, wasted requests and latency for each policy. Runs are spread across all cores.
+//
+// Usage: chartboost_tuner [options] trace...
+//   --max-in-flight LIST      Values to try for SchedulerPolicy::maxInFlight, comma separated (default 1)
+//   --max-retries LIST        (default 3)
+//   --retry-backoff LIST      (default 5)
+//   --request-timeout LIST    (default 30)
+//   --defer-outside-idle LIST 0 or 1 (default 1)
+//   --runs N                  Simulated runs of each trace per policy, with different seeds (default 1)
+//   --seed N                  Base seed (default 1)
+//   --jobs N                  Worker threads (default: one per core)
+//   --tick SECONDS            Virtual time step between scheduler updates (default 0.1)
+//   --assert CHECK            Exits with status 2 if any policy fails the check, a column name, <= or >= and a value,
+//                             e.g. --assert availability>=0.9. May be given more than once
+//
+// Traces are text, one entry per line, with times in seconds from the start of the session and '#' starting a comment:
+//   <time> request <adType> <location> <urgent 0|1>
+//   <time> idle_begin
+//   <time> idle_end
+//   <time> show <adType> <location>
+// Traces may also contain the scenario directives described in ChartboostSimulator.h, which script how the simulated SDK
+// answers (placement fill rates and latencies, scripted outcomes and errors, offline periods, reordered and duplicated callbacks).
+// Placements without directives answer with the simulator's defaults.
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ChartboostScheduler.h"
+#include "ChartboostSimulator.h"
+
+using namespace samcodeschartboost;
+
+namespace
+{
+	enum EventKind
+	{
+		EVENT_REQUEST,
+		EVENT_IDLE_BEGIN,
+		EVENT_IDLE_END,
+		EVENT_SHOW
+	};
+	
+	struct TraceEvent
+	{
+		double time;
+		EventKind kind;
+		int adType;
+		std::string location;
+		bool urgent;
+	};
+	
+	struct Trace
+	{
+		std::string path;
+		SimulatedScenario scenario;
+		std::vector<TraceEvent> events;
+	};
+	
+	struct Job
+	{
+		size_t policy;
+		size_t trace;
+		int run;
+	};
+	
+	struct Result
+	{
+		int shows;
+		int showsAvailable;
+		int cacheRequests;
+		double queueTime;
+		int issued;
+		int retries;
+		int timeouts;
+		std::vector<double> latencies; // Seconds from the game's request to the placement being cached
+	};
+	
+	struct Waiting
+	{
+		int adType;
+		std::string location;
+		double since;
+	};
+	
+	bool parseTrace(const char* path, Trace& trace)
+	{
+		std::ifstream file(path);
+		if(!file) {
+			fprintf(stderr, "Couldn't open trace %s\n", path);
+			return false;
+		}
+		
+		trace.path = path;
+		std::string line;
+		int lineNumber = 0;
+		while(std::getline(file, line)) {
+			lineNumber++;
+			size_t comment = line.find('#');
+			if(comment != std::string::npos) {
+				line.erase(comment);
+			}
+			std::istringstream in(line);
+			std::string first;
+			if(!(in >> first)) {
+				continue;
+			}
+			
+			bool ok = true;
+			if(isScenarioDirective(first)) {
+				ok = parseScenarioDirective(first, in, trace.scenario);
+			} else {
+				TraceEvent event;
+				event.adType = 0;
+				event.urgent = false;
+				std::string kind;
+				char* end = NULL;
+				event.time = strtod(first.c_str(), &end);
+				ok = *end == '\0' && (bool)(in >> kind);
+				if(ok && kind == "request") {
+					int urgent = 0;
+					event.kind = EVENT_REQUEST;
+					ok = (bool)(in >> event.adType >> event.location >> urgent);
+					event.urgent = urgent != 0;
+				} else if(ok && kind == "show") {
+					event.kind = EVENT_SHOW;
+					ok = (bool)(in >> event.adType >> event.location);
+				} else if(ok && kind == "idle_begin") {
+					event.kind = EVENT_IDLE_BEGIN;
+				} else if(ok && kind == "idle_end") {
+					event.kind = EVENT_IDLE_END;
+				} else {
+					ok = false;
+				}
+				if(ok) {
+					trace.events.push_back(event);
+				}
+			}
+			
+			if(!ok) {
+				fprintf(stderr, "%s:%d: couldn't parse '%s'\n", path, lineNumber, line.c_str());
+				return false;
+			}
+		}
+		
+		std::stable_sort(trace.events.begin(), trace.events.end(), [](const TraceEvent& a, const TraceEvent& b) { return a.time < b.time; });
+		return true;
+	}
+	
+	bool parseList(const char* text, std::vector<double>& values)
+	{
+		values.clear();
+		std::stringstream in(text);
+		std::string item;
+		while(std::getline(in, item, ',')) {
+			char* end = NULL;
+			double value = strtod(item.c_str(), &end);
+			if(item.empty() || *end != '\0') {
+				return false;
+			}
+			values.push_back(value);
+		}
+		return !values.empty();
+	}
+	
+	void checkWaiting(SimulatedSdk& sdk, std::vector<Waiting>& waiting, double now, Result& result)
+	{
+		for(size_t i = waiting.size(); i-- > 0;) {
+			if(sdk.isCached(waiting[i].adType, waiting[i].location.c_str())) {
+				result.latencies.push_back(now - waiting[i].since);
+				waiting.erase(waiting.begin() + i);
+			}
+		}
+	}
+	
+	void step(SimulatedSdk& sdk, Scheduler& scheduler, std::vector<Waiting>& waiting, double now, Result& result)
+	{
+		sdk.advance(now);
+		scheduler.update(now);
+		checkWaiting(sdk, waiting, now, result);
+	}
+	
+	Result replay(const Trace& trace, const SchedulerPolicy& policy, unsigned int seed, double tick)
+	{
+		SimulatedSdk sdk(seed);
+		sdk.setScenario(trace.scenario);
+		Scheduler scheduler(&sdk);
+		scheduler.setPolicy(policy);
+		sdk.setScheduler(&scheduler);
+		
+		Result result = Result();
+		std::vector<Waiting> waiting;
+		double clock = 0.0;
+		for(size_t i = 0; i < trace.events.size(); i++) {
+			const TraceEvent& event = trace.events[i];
+			while(clock + tick < event.time) {
+				clock += tick;
+				step(sdk, scheduler, waiting, clock, result);
+			}
+			clock = std::max(clock, event.time);
+			step(sdk, scheduler, waiting, clock, result);
+			
+			switch(event.kind) {
+				case EVENT_REQUEST: {
+					bool known = sdk.isCached(event.adType, event.location.c_str());
+					for(size_t w = 0; w < waiting.size() && !known; w++) {
+						known = waiting[w].adType == event.adType && waiting[w].location == event.location;
+					}
+					if(!known) {
+						Waiting entry;
+						entry.adType = event.adType;
+						entry.location = event.location;
+						entry.since = clock;
+						waiting.push_back(entry);
+					}
+					scheduler.request(event.adType, event.location.c_str(), event.urgent, clock);
+					break;
+				}
+				case EVENT_IDLE_BEGIN:
+					scheduler.beginIdleWindow(clock);
+					break;
+				case EVENT_IDLE_END:
+					scheduler.endIdleWindow(clock);
+					break;
+				case EVENT_SHOW:
+					sdk.show(event.adType, event.location.c_str());
+					for(size_t w = waiting.size(); w-- > 0;) {
+						if(waiting[w].adType == event.adType && waiting[w].location == event.location) {
+							waiting.erase(waiting.begin() + w);
+						}
+					}
+					checkWaiting(sdk, waiting, clock, result);
+					break;
+			}
+		}
+		
+		const SimulatorStats& sdkStats = sdk.getStats();
+		SchedulerStats schedulerStats = scheduler.getStats();
+		result.shows = sdkStats.shows;
+		result.showsAvailable = sdkStats.showsAvailable;
+		result.cacheRequests = sdkStats.cacheRequests;
+		result.queueTime = schedulerStats.totalQueueTime;
+		result.issued = schedulerStats.issued;
+		result.retries = schedulerStats.retries;
+		result.timeouts = schedulerStats.timeouts;
+		return result;
+	}
+	
+	// The result columns that checks can be made against, in output order
+	const char* const metricNames[] = { "availability", "cache_requests", "wasted_requests", "mean_latency", "p95_latency", "mean_queue_time", "retries", "timeouts" };
+	const int METRIC_COUNT = sizeof(metricNames) / sizeof(metricNames[0]);
+	
+	struct Check
+	{
+		std::string text;
+		int metric;
+		bool atLeast;
+		double value;
+	};
+	
+	bool parseCheck(const char* text, Check& check)
+	{
+		std::string spec(text);
+		size_t op = spec.find("<=");
+		check.atLeast = false;
+		if(op == std::string::npos) {
+			op = spec.find(">=");
+			check.atLeast = true;
+		}
+		if(op == std::string::npos) {
+			return false;
+		}
+		check.text = spec;
+		check.metric = -1;
+		for(int i = 0; i < METRIC_COUNT; i++) {
+			if(spec.compare(0, op, metricNames[i]) == 0 && strlen(metricNames[i]) == op) {
+				check.metric = i;
+			}
+		}
+		char* end = NULL;
+		check.value = strtod(spec.c_str() + op + 2, &end);
+		return check.metric >= 0 && end != spec.c_str() + op + 2 && *end == '\0';
+	}
+	
+	void usage()
+	{
+		fprintf(stderr, "Usage: chartboost_tuner [--max-in-flight LIST] [--max-retries LIST] [--retry-backoff LIST] [--request-timeout LIST] [--defer-outside-idle LIST] [--runs N] [--seed N] [--jobs N] [--tick SECONDS] [--assert CHECK]... trace...\n");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<double> maxInFlight(1, 1.0);
+	std::vector<double> maxRetries(1, 3.0);
+	std::vector<double> retryBackoff(1, 5.0);
+	std::vector<double> requestTimeout(1, 30.0);
+	std::vector<double> deferOutsideIdle(1, 1.0);
+	int runs = 1;
+	unsigned int seed = 1;
+	int jobCount = (int)std::thread::hardware_concurrency();
+	double tick = 0.1;
+	std::vector<Check> checks;
+	std::vector<Trace> traces;
+	
+	for(int i = 1; i < argc; i++) {
+		const char* arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		bool ok = true;
+		if(strncmp(arg, "--", 2) != 0) {
+			traces.push_back(Trace());
+			if(!parseTrace(arg, traces.back())) {
+				return 1;
+			}
+			continue;
+		}
+		if(!hasValue) {
+			usage();
+			return 1;
+		}
+		const char* value = argv[++i];
+		if(strcmp(arg, "--max-in-flight") == 0) {
+			ok = parseList(value, maxInFlight);
+		} else if(strcmp(arg, "--max-retries") == 0) {
+			ok = parseList(value, maxRetries);
+		} else if(strcmp(arg, "--retry-backoff") == 0) {
+			ok = parseList(value, retryBackoff);
+		} else if(strcmp(arg, "--request-timeout") == 0) {
+			ok = parseList(value, requestTimeout);
+		} else if(strcmp(arg, "--defer-outside-idle") == 0) {
+			ok = parseList(value, deferOutsideIdle);
+		} else if(strcmp(arg, "--runs") == 0) {
+			runs = atoi(value);
+			ok = runs > 0;
+		} else if(strcmp(arg, "--seed") == 0) {
+			char* end = NULL;
+			unsigned long parsed = strtoul(value, &end, 10);
+			ok = isdigit((unsigned char)value[0]) && *end == '\0' && parsed <= 0xFFFFFFFFul;
+			seed = (unsigned int)parsed;
+		} else if(strcmp(arg, "--jobs") == 0) {
+			jobCount = atoi(value);
+			ok = jobCount > 0;
+		} else if(strcmp(arg, "--tick") == 0) {
+			tick = atof(value);
+			ok = tick > 0.0;
+		} else if(strcmp(arg, "--assert") == 0) {
+			checks.push_back(Check());
+			ok = parseCheck(value, checks.back());
+		} else {
+			ok = false;
+		}
+		if(!ok) {
+			fprintf(stderr, "Bad option %s %s\n", arg, value);
+			usage();
+			return 1;
+		}
+	}
+	if(traces.empty()) {
+		usage();
+		return 1;
+	}
+	
+	std::vector<SchedulerPolicy> policies;
+	for(size_t a = 0; a < maxInFlight.size(); a++)
+	for(size_t b = 0; b < maxRetries.size(); b++)
+	for(size_t c = 0; c < retryBackoff.size(); c++)
+	for(size_t d = 0; d < requestTimeout.size(); d++)
+	for(size_t e = 0; e < deferOutsideIdle.size(); e++) {
+		SchedulerPolicy policy;
+		policy.maxInFlight = (int)maxInFlight[a];
+		policy.maxRetries = (int)maxRetries[b];
+		policy.retryBackoff = retryBackoff[c];
+		policy.requestTimeout = requestTimeout[d];
+		policy.deferOutsideIdle = deferOutsideIdle[e] != 0.0;
+		policies.push_back(policy);
+	}
+	
+	std::vector<Job> jobs;
+	for(size_t p = 0; p < policies.size(); p++) {
+		for(size_t t = 0; t < traces.size(); t++) {
+			for(int r = 0; r < runs; r++) {
+				Job job;
+				job.policy = p;
+				job.trace = t;
+				job.run = r;
+				jobs.push_back(job);
+			}
+		}
+	}
+	
+	// Every job owns its scheduler and simulator, so workers share nothing but the job index.
+	// Seeds depend only on the trace and run, so every policy is compared against the same simulated SDK behaviour
+	std::vector<Result> results(jobs.size());
+	std::atomic<size_t> nextJob(0);
+	std::vector<std::thread> workers;
+	jobCount = std::max(1, std::min(jobCount, (int)jobs.size()));
+	for(int w = 0; w < jobCount; w++) {
+		workers.push_back(std::thread([&]() {
+			for(size_t j = nextJob++; j < jobs.size(); j = nextJob++) {
+				const Job& job = jobs[j];
+				unsigned int jobSeed = seed + (unsigned int)(job.trace * 7919 + job.run * 104729);
+				results[j] = replay(traces[job.trace], policies[job.policy], jobSeed, tick);
+			}
+		}));
+	}
+	for(size_t w = 0; w < workers.size(); w++) {
+		workers[w].join();
+	}
+	
+	printf("max_in_flight\tmax_retries\tretry_backoff\trequest_timeout\tdefer_outside_idle\tavailability\tcache_requests\twasted_requests\tmean_latency\tp95_latency\tmean_queue_time\tretries\ttimeouts\n");
+	bool passed = true;
+	for(size_t p = 0; p < policies.size(); p++) {
+		Result total = Result();
+		for(size_t j = 0; j < jobs.size(); j++) {
+			if(jobs[j].policy != p) {
+				continue;
+			}
+			total.shows += results[j].shows;
+			total.showsAvailable += results[j].showsAvailable;
+			total.cacheRequests += results[j].cacheRequests;
+			total.queueTime += results[j].queueTime;
+			total.issued += results[j].issued;
+			total.retries += results[j].retries;
+			total.timeouts += results[j].timeouts;
+			total.latencies.insert(total.latencies.end(), results[j].latencies.begin(), results[j].latencies.end());
+		}
+		
+		double meanLatency = 0.0;
+		double p95Latency = 0.0;
+		if(!total.latencies.empty()) {
+			std::sort(total.latencies.begin(), total.latencies.end());
+			for(size_t i = 0; i < total.latencies.size(); i++) {
+				meanLatency += total.latencies[i];
+			}
+			meanLatency /= total.latencies.size();
+			// Nearest rank, ceil(0.95 * n) - 1, so small samples still reach their slowest latencies
+			p95Latency = total.latencies[(total.latencies.size() * 95 + 99) / 100 - 1];
+		}
+		
+		// A wasted request is one sent to the SDK that never ended up in a shown ad
+		double metrics[METRIC_COUNT] = {
+			total.shows > 0 ? (double)total.showsAvailable / total.shows : 0.0,
+			(double)total.cacheRequests,
+			(double)(total.cacheRequests - total.showsAvailable),
+			meanLatency,
+			p95Latency,
+			total.issued > 0 ? total.queueTime / total.issued : 0.0,
+			(double)total.retries,
+			(double)total.timeouts
+		};
+		const SchedulerPolicy& policy = policies[p];
+		printf("%d\t%d\t%g\t%g\t%d\t%.4f\t%d\t%d\t%.3f\t%.3f\t%.3f\t%d\t%d\n",
+			policy.maxInFlight, policy.maxRetries, policy.retryBackoff, policy.requestTimeout, policy.deferOutsideIdle ? 1 : 0,
+			metrics[0], total.cacheRequests, total.cacheRequests - total.showsAvailable,
+			meanLatency, p95Latency, metrics[5], total.retries, total.timeouts);
+		
+		for(size_t c = 0; c < checks.size(); c++) {
+			const Check& check = checks[c];
+			double actual = metrics[check.metric];
+			if(check.atLeast ? actual < check.value : actual > check.value) {
+				fprintf(stderr, "Policy %d/%d/%g/%g/%d failed %s, got %g\n", policy.maxInFlight, policy.maxRetries, policy.retryBackoff, policy.requestTimeout, policy.deferOutsideIdle ? 1 : 0, check.text.c_str(), actual);
+				passed = false;
+			}
+		}
+	}
+	return passed ? 0 : 2;
+}
\ No newline at end of file
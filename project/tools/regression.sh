@@ -0,0 +1,44 @@
+#!/bin/sh
+# Scheduler regression checks: replays the example trace and scenario with fixed seeds and fails if any policy misses
+# its thresholds. The thresholds leave headroom over the current results, since the latency distributions the simulator
+# draws from differ slightly between standard libraries.
+#
+# Run from /project after building the tuner with: haxelib run hxcpp Build.xml tuner
+# Set TUNER to use a tuner built elsewhere.
+
+TUNER=${TUNER:-tools/chartboost_tuner}
+if [ ! -x "$TUNER" ]; then
+	echo "No tuner at $TUNER, build it with: haxelib run hxcpp Build.xml tuner" >&2
+	exit 1
+fi
+
+status=0
+
+check() {
+	name=$1
+	shift
+	echo "== $name"
+	if ! "$TUNER" "$@"; then
+		echo "FAILED: $name" >&2
+		status=1
+	fi
+}
+
+# A well behaved session with the default policy
+check "example trace" --seed 1 \
+	--assert availability\>=0.6 \
+	--assert wasted_requests\<=2 \
+	--assert p95_latency\<=20 \
+	--assert timeouts\<=0 \
+	tools/example_trace.txt
+
+# Flaky and slow placements, an outage, and reordered and duplicated callbacks, over several runs
+check "example scenario" --seed 1 --runs 8 --max-in-flight 1,2 --defer-outside-idle 0 \
+	--assert availability\>=0.5 \
+	--assert mean_latency\<=20 \
+	--assert p95_latency\<=40 \
+	--assert timeouts\<=12 \
+	--assert retries\<=70 \
+	tools/example_scenario.txt
+
+exit $status
\ No newline at end of file